@@ -1,14 +1,32 @@
 #include "CLI.h"
+#include "../modules/sweep/SweepRunner.h"
+#include "../modules/snapshot/Snapshot.h"
+#include "../modules/workload/WorkloadGenerator.h"
+#include "../modules/workload/JobTrace.h"
 #include <iostream>
+#include <algorithm>
 
 CLI::CLI() {
     mem = new MemoryManager(DEFAULT_NUM_FRAMES);
     prodCons = new ProducerConsumer(DEFAULT_BUFFER_SIZE);
-    sched = new SchedulerRR(*mem, *prodCons, DEFAULT_QUANTUM);
+    policy = SchedPolicy::RR;
+    sched = makeScheduler(policy, *mem, *prodCons, DEFAULT_QUANTUM);
     heap = new HeapAllocator(1024 * 64, 64); // 64KB heap, bloques mínimos de 64B
+    trace.bind(currentState());
+}
+
+SimState CLI::currentState() const {
+    SimState state;
+    state.sched = sched;
+    state.mem = mem;
+    state.prodCons = prodCons;
+    state.heap = heap;
+    return state;
 }
 
 CLI::~CLI() {
+    trace.stop();
+    stopTimeline();
     delete heap;
     delete sched;
     delete prodCons;
@@ -27,6 +45,8 @@ void CLI::showMenu() {
     std::cout << "│ 3.  Crear proceso consumidor            │\n";
     std::cout << "│ 4.  Mostrar procesos (tabla simple)     │\n";
     std::cout << "│ 5.  Terminar proceso                    │\n";
+    std::cout << "│ 29. Programar llegada de proceso        │\n";
+    std::cout << "│ 30. Dormir proceso (sleep)              │\n";
     std::cout << "├─────────────────────────────────────────┤\n";
     std::cout << "│  GESTIÓN DE HILOS                       │\n";
     std::cout << "├─────────────────────────────────────────┤\n";
@@ -56,46 +76,91 @@ void CLI::showMenu() {
     std::cout << "├─────────────────────────────────────────┤\n";
     std::cout << "│ 12. Cambiar tamaño de memoria           │\n";
     std::cout << "│ 13. Cambiar algoritmo de paginación     │\n";
+    std::cout << "│ 21. Cambiar política de planificación   │\n";
+    std::cout << "│ 31. Timeout de espera en semáforos      │\n";
+    std::cout << "│ 32. Modelo de acceso a memoria          │\n";
+    std::cout << "├─────────────────────────────────────────┤\n";
+    std::cout << "│  EXPERIMENTOS                           │\n";
+    std::cout << "├─────────────────────────────────────────┤\n";
+    std::cout << "│ 20. Barrido de parámetros (paralelo)    │\n";
+    std::cout << "│ 22. Guardar snapshot                    │\n";
+    std::cout << "│ 23. Restaurar snapshot                  │\n";
+    std::cout << "│ 24. Grabar traza (iniciar/detener)      │\n";
+    std::cout << "│ 25. Reproducir y verificar traza        │\n";
+    std::cout << "│ 26. Generar carga sintética             │\n";
+    std::cout << "│ 27. Cargar traza de trabajos (CSV/bin)  │\n";
+    std::cout << "│ 28. Línea de tiempo JSON (on/off)       │\n";
+    std::cout << "│ 33. Referencias a memoria vs. OPT       │\n";
     std::cout << "├─────────────────────────────────────────┤\n";
     std::cout << "│ 0.  Salir                               │\n";
     std::cout << "└─────────────────────────────────────────┘\n";
 }
 
+void CLI::stopTimeline() {
+    if (!timeline.isActive()) return;
+    sched->setTimeline(nullptr);
+    long long events = timeline.getEventCount();
+    timeline.stop();
+    std::cout << "Línea de tiempo finalizada: " << events << " eventos.\n";
+}
+
+void CLI::askPriority(int pid) {
+    if (policy != SchedPolicy::PRIORITY && policy != SchedPolicy::CFS) return;
+    int prio;
+    std::cout << "Prioridad (-20 = máxima .. 19): "; std::cin >> prio;
+    trace.setPriority(pid, prio);
+}
+
 void CLI::handleOption(int opcion) {
     if (opcion == 1) {
-        int burst, pages;
+        int burst, pages, period = 0;
         std::cout << "Ingrese ráfagas (ticks): "; std::cin >> burst;
         std::cout << "Ingrese número de páginas: "; std::cin >> pages;
-        int pid = sched->createProcess(burst, pages, ProcType::NORMAL);
+        if (policy == SchedPolicy::EDF || policy == SchedPolicy::RM) {
+            std::cout << "Período (0 = aperiódico): "; std::cin >> period;
+        }
+        if (period > 0) {
+            // Tarea periódica: la ráfaga es el WCET de cada activación
+            int deadline;
+            std::cout << "Plazo relativo (0 = período): "; std::cin >> deadline;
+            int pid = trace.createPeriodicTask(burst, period, deadline, pages);
+            if (pid == -1) std::cout << "Tarea rechazada (parámetros o admisión).\n";
+            else std::cout << "Tarea periódica creada con PID=" << pid << "\n";
+            return;
+        }
+        int pid = trace.createProcess(burst, pages, ProcType::NORMAL);
         std::cout << "Proceso NORMAL creado con PID=" << pid << "\n";
+        askPriority(pid);
     }
     else if (opcion == 2) {
         int burst, pages;
         std::cout << "Ingrese ráfagas (ticks): "; std::cin >> burst;
         std::cout << "Ingrese número de páginas: "; std::cin >> pages;
-        int pid = sched->createProcess(burst, pages, ProcType::PRODUCER);
+        int pid = trace.createProcess(burst, pages, ProcType::PRODUCER);
         std::cout << "Proceso PRODUCTOR creado con PID=" << pid << "\n";
+        askPriority(pid);
     }
     else if (opcion == 3) {
         int burst, pages;
         std::cout << "Ingrese ráfagas (ticks): "; std::cin >> burst;
         std::cout << "Ingrese número de páginas: "; std::cin >> pages;
-        int pid = sched->createProcess(burst, pages, ProcType::CONSUMER);
+        int pid = trace.createProcess(burst, pages, ProcType::CONSUMER);
         std::cout << "Proceso CONSUMIDOR creado con PID=" << pid << "\n";
+        askPriority(pid);
     }
     else if (opcion == 4) sched->listProcesses();
     else if (opcion == 5) {
         int pid; std::cout << "PID a terminar: "; std::cin >> pid;
-        if (sched->killProcess(pid)) std::cout << "Proceso " << pid << " terminado.\n";
+        if (trace.killProcess(pid)) std::cout << "Proceso " << pid << " terminado.\n";
         else std::cout << "PID no encontrado.\n";
     }
     else if (opcion == 6) { 
-        sched->tick(); 
+        trace.tick(); 
         std::cout << "Avanzado 1 tick. Tick actual: " << sched->getTick() << "\n"; 
     }
     else if (opcion == 7) {
         int n; std::cout << "Cuántos ticks desea ejecutar: "; std::cin >> n;
-        sched->runTicks(n);
+        trace.runTicks(n);
         std::cout << "Ejecutados " << n << " ticks. Tick actual: " << sched->getTick() << "\n";
     }
     else if (opcion == 8) sched->showStats();
@@ -104,28 +169,43 @@ void CLI::handleOption(int opcion) {
     else if (opcion == 11) prodCons->showBuffer();
     else if (opcion == 12) {
         int n; std::cout << "Nuevo número de marcos: "; std::cin >> n;
-        mem->setNumFrames(n);
+        trace.setNumFrames(n);
         std::cout << "Tamaño de memoria actualizado.\n";
     }
     else if (opcion == 13) {
         int m;
-        std::cout << "Seleccione algoritmo de paginación (1=FIFO, 2=LRU): ";
+        std::cout << "Seleccione algoritmo de paginación (1=FIFO, 2=LRU, 3=PFF, 4=CLOCK,\n"
+                  << "  5=Segunda oportunidad, 6=CLOCK mejorado, 7=LFU, 8=ARC, 9=WS): ";
         std::cin >> m;
-        mem->setAlgorithm(m == 2 ? PageAlgo::LRU : PageAlgo::FIFO);
-        std::cout << "Algoritmo actualizado.\n";
+        // OPT necesita la cadena completa: se compara aparte (opción 33)
+        PageAlgo algo = m >= 1 && m <= (int)PageAlgo::OPT ? (PageAlgo)(m - 1)
+                      : m == 9 ? PageAlgo::WS : PageAlgo::FIFO;
+        if (algo == PageAlgo::PFF) {
+            int high, low, window;
+            std::cout << "Ventana (accesos del proceso, máx 64): "; std::cin >> window;
+            std::cout << "Crecer con más de N fallos por ventana: "; std::cin >> high;
+            std::cout << "Achicar con menos de N fallos por ventana: "; std::cin >> low;
+            trace.setPFFParams(high, low, window);
+        } else if (algo == PageAlgo::WS) {
+            int tau;
+            std::cout << "Ventana τ (accesos del proceso): "; std::cin >> tau;
+            trace.setWorkingSetWindow(tau);
+        }
+        trace.setPageAlgorithm(algo);
+        std::cout << "Algoritmo actualizado: " << mem->getAlgorithmName() << ".\n";
     }
     else if (opcion == 14) {
         int pid, numThreads, burstPerThread;
         std::cout << "PID del proceso: "; std::cin >> pid;
-        std::cout << "Número de hilos a crear (máx " << MAX_THREADS_PER_PROCESS << "): "; std::cin >> numThreads;
+        std::cout << "Número de hilos a crear (máx " << sched->getThreadLimit() << "): "; std::cin >> numThreads;
         std::cout << "Burst por hilo: "; std::cin >> burstPerThread;
         
-        if (numThreads > MAX_THREADS_PER_PROCESS) {
-            std::cout << "Error: Máximo " << MAX_THREADS_PER_PROCESS << " hilos por proceso.\n";
+        if (numThreads > sched->getThreadLimit()) {
+            std::cout << "Error: Máximo " << sched->getThreadLimit() << " hilos por proceso.\n";
         } else {
             int created = 0;
             for (int i = 0; i < numThreads; i++) {
-                int tid = sched->createThreadInProcess(pid, burstPerThread);
+                int tid = trace.createThreadInProcess(pid, burstPerThread);
                 if (tid != -1) created++;
             }
             if (created > 0) {
@@ -143,7 +223,7 @@ void CLI::handleOption(int opcion) {
     else if (opcion == 16) {
         size_t size;
         std::cout << "Tamaño a asignar (bytes): "; std::cin >> size;
-        void* ptr = heap->allocate(size);
+        void* ptr = trace.heapAllocate(size);
         if (ptr) {
             std::cout << "✓ Memoria asignada en dirección: 0x" << std::hex << reinterpret_cast<size_t>(ptr) << std::dec << "\n";
         } else {
@@ -154,7 +234,7 @@ void CLI::handleOption(int opcion) {
         size_t addr;
         std::cout << "Dirección a liberar (hex, sin 0x): "; std::cin >> std::hex >> addr >> std::dec;
         void* ptr = reinterpret_cast<void*>(addr);
-        if (heap->deallocate(ptr)) {
+        if (trace.heapFree(ptr)) {
             std::cout << "✓ Memoria liberada correctamente\n";
         } else {
             std::cout << "✗ Error: Dirección inválida\n";
@@ -167,6 +247,235 @@ void CLI::handleOption(int opcion) {
         heap->showFragmentation();
         heap->showAllocationMap();
     }
+    else if (opcion == 20) {
+        // Quantum x marcos x algoritmo, cada punto con su propia simulación
+        SweepConfig base;
+        base.policy = policy;
+        int threads;
+        std::cout << "Procesos por simulación: "; std::cin >> base.numProcs;
+        std::cout << "Ticks por simulación: "; std::cin >> base.ticks;
+        std::cout << "Hilos del host (0 = todos los núcleos): "; std::cin >> threads;
+        SweepRunner sweep;
+        sweep.addGrid({1, 2, 3, 4, 6, 8}, {2, 4, 8, 16},
+                      {PageAlgo::FIFO, PageAlgo::LRU, PageAlgo::PFF, PageAlgo::CLOCK,
+                       PageAlgo::SECOND_CHANCE, PageAlgo::ENHANCED_CLOCK, PageAlgo::LFU,
+                       PageAlgo::ARC, PageAlgo::WS}, base);
+        sweep.run(threads);
+        sweep.showResults();
+    }
+    else if (opcion == 21) {
+        int m, q = DEFAULT_QUANTUM, cpus = 4;
+        std::cout << "Política (1=RR, 2=SJF, 3=SRTF, 4=Prioridad, 5=MLFQ, 6=CFS,\n"
+                  << "  7=EDF, 8=Rate Monotonic, 9=SMP): "; std::cin >> m;
+        SchedPolicy next = m >= 1 && m <= SCHED_POLICY_COUNT ? (SchedPolicy)(m - 1) : SchedPolicy::RR;
+        if (next == SchedPolicy::RR || next == SchedPolicy::PRIORITY || next == SchedPolicy::SMP) {
+            std::cout << "Quantum: "; std::cin >> q;
+            if (q < 1) q = DEFAULT_QUANTUM;
+        }
+        if (next == SchedPolicy::SMP) {
+            std::cout << "CPUs (1-64): "; std::cin >> cpus;
+        }
+        // La simulación se reinicia: los PIDs del planificador anterior
+        // no deben quedar en los marcos ni en el buffer
+        if (trace.stop()) std::cout << "Grabación de traza finalizada.\n";
+        stopTimeline();
+        delete sched;
+        delete prodCons;
+        mem->setNumFrames(mem->getNumFrames());
+        prodCons = new ProducerConsumer(DEFAULT_BUFFER_SIZE);
+        policy = next;
+        sched = makeScheduler(policy, *mem, *prodCons, q, cpus);
+        trace.bind(currentState());
+        std::cout << "Política actualizada: " << schedPolicyName(policy)
+                  << " (simulación reiniciada).\n";
+    }
+    else if (opcion == 22 || opcion == 23) {
+        std::string path, error;
+        std::cout << "Archivo: "; std::cin >> path;
+        SimState state = currentState();
+        // Restaurar corta la traza: lo grabado ya no describe el estado
+        if (opcion == 23 && trace.stop()) std::cout << "Grabación de traza finalizada.\n";
+        // El reloj restaurado puede retroceder: la línea de tiempo se corta
+        if (opcion == 23) stopTimeline();
+        if (opcion == 22 && saveSnapshot(path, state, &error))
+            std::cout << "Snapshot guardado en " << path << ".\n";
+        else if (opcion == 23 && loadSnapshot(path, state, &error))
+            std::cout << "Snapshot restaurado (tick " << sched->getTick() << ").\n";
+        else
+            std::cout << "Error: " << error << "\n";
+    }
+    else if (opcion == 24) {
+        if (trace.isRecording()) {
+            long long events = trace.getEventCount();
+            trace.stop();
+            std::cout << "Grabación finalizada: " << events << " eventos.\n";
+        } else {
+            std::string path, error;
+            std::cout << "Archivo de traza: "; std::cin >> path;
+            if (trace.start(path, policy, &error))
+                std::cout << "Grabando entradas en " << path << " (opción 24 para detener).\n";
+            else
+                std::cout << "Error: " << error << "\n";
+        }
+    }
+    else if (opcion == 25) {
+        std::string path;
+        std::cout << "Archivo de traza: "; std::cin >> path;
+        TraceReplayer replayer;
+        TraceReplayResult res = replayer.replay(path);
+        std::cout << "Eventos reproducidos: " << res.events << " en " << res.elapsedMs << " ms"
+                  << " | Tick final: " << res.finalTick << "\n";
+        std::cout << std::hex << "Hash grabado: " << res.recordedHash
+                  << " | Hash reproducido: " << res.replayHash << std::dec << "\n";
+        if (res.ok) std::cout << "✓ Reproducción idéntica a la grabación.\n";
+        else {
+            std::cout << "✗ " << res.error;
+            if (res.divergedAt >= 0) std::cout << " (evento " << res.divergedAt << ")";
+            std::cout << "\n";
+        }
+    }
+    else if (opcion == 26) {
+        WorkloadConfig cfg;
+        int a, b;
+        std::cout << "Procesos a generar: "; std::cin >> cfg.numProcs;
+        std::cout << "Llegadas (1=Poisson, 2=Ráfagas, 3=Diurna): "; std::cin >> a;
+        std::cout << "Tasa media (procesos/tick): "; std::cin >> cfg.arrivalRate;
+        std::cout << "Ráfagas de CPU (1=Exponencial, 2=Pareto, 3=Bimodal): "; std::cin >> b;
+        std::cout << "Ráfaga media (ticks): "; std::cin >> cfg.meanBurst;
+        std::cout << "Semilla: "; std::cin >> cfg.seed;
+        std::cout << "Liberar terminados cada N ticks (0 = nunca): "; std::cin >> cfg.reapInterval;
+        cfg.arrival = a == 2 ? ArrivalModel::BURSTY : a == 3 ? ArrivalModel::DIURNAL : ArrivalModel::POISSON;
+        cfg.burst = b == 2 ? BurstModel::PARETO : b == 3 ? BurstModel::BIMODAL : BurstModel::EXPONENTIAL;
+        // La carga va directo al planificador, sin pasar por la traza
+        if (trace.stop()) std::cout << "Grabación de traza finalizada.\n";
+        WorkloadGenerator gen(cfg);
+        WorkloadGenerator::showStats(gen.run(*sched));
+        std::cout << arrivalModelName(cfg.arrival) << " / " << burstModelName(cfg.burst)
+                  << " | Tick actual: " << sched->getTick() << "\n";
+    }
+    else if (opcion == 27) {
+        std::string path, error;
+        int reap;
+        std::cout << "Archivo de trabajos (CSV o binario): "; std::cin >> path;
+        std::cout << "Liberar terminados cada N ticks (0 = nunca): "; std::cin >> reap;
+        JobTraceInjector jobs;
+        if (jobs.open(path, &error)) {
+            if (trace.stop()) std::cout << "Grabación de traza finalizada.\n";
+            // Sin IOManager en el CLI: las E/S de la traza se cuentan como descartadas
+            JobTraceInjector::showStats(jobs.run(*sched, nullptr, reap));
+            if (!jobs.lastError().empty()) std::cout << "✗ " << jobs.lastError() << "\n";
+            std::cout << "Tick actual: " << sched->getTick() << "\n";
+        } else {
+            std::cout << "Error: " << error << "\n";
+        }
+    }
+    else if (opcion == 28) {
+        if (timeline.isActive()) {
+            stopTimeline();
+        } else {
+            std::string path, error;
+            std::cout << "Archivo JSON (chrome://tracing / ui.perfetto.dev): "; std::cin >> path;
+            if (timeline.start(path, 1000, 1 << 16, &error)) {
+                sched->setTimeline(&timeline);
+                std::cout << "Registrando línea de tiempo en " << path
+                          << " (1 tick = 1 ms; opción 28 para detener).\n";
+            } else {
+                std::cout << "Error: " << error << "\n";
+            }
+        }
+    }
+    else if (opcion == 29) {
+        int arrival, burst, pages, t;
+        std::cout << "Tick de llegada (actual " << sched->getTick() << "): "; std::cin >> arrival;
+        std::cout << "Ingrese ráfagas (ticks): "; std::cin >> burst;
+        std::cout << "Ingrese número de páginas: "; std::cin >> pages;
+        std::cout << "Tipo (1=Normal, 2=Productor, 3=Consumidor): "; std::cin >> t;
+        ProcType type = t == 2 ? ProcType::PRODUCER : t == 3 ? ProcType::CONSUMER : ProcType::NORMAL;
+        int pid = trace.scheduleProcess(arrival, burst, pages, type);
+        std::cout << "Proceso " << procTypeName(type) << " PID=" << pid << " llega en el tick "
+                  << std::max(arrival, sched->getTick()) << ".\n";
+        askPriority(pid);
+    }
+    else if (opcion == 30) {
+        int pid, ticks;
+        std::cout << "PID a dormir: "; std::cin >> pid;
+        std::cout << "Ticks: "; std::cin >> ticks;
+        if (trace.sleepProcess(pid, ticks))
+            std::cout << "Proceso " << pid << " dormido hasta el tick " << sched->getTick() + ticks << ".\n";
+        else
+            std::cout << "Error: el proceso debe existir y estar READY o RUNNING (ticks > 0).\n";
+    }
+    else if (opcion == 31) {
+        int ticks;
+        std::cout << "Ticks máximos de espera en un semáforo (0 = sin límite, actual "
+                  << sched->getWaitTimeout() << "): "; std::cin >> ticks;
+        trace.setWaitTimeout(ticks);
+        std::cout << "Timeout actualizado.\n";
+    }
+    else if (opcion == 32) {
+        int m, pid;
+        std::cout << "Modelo (1=Secuencial, 2=Working set, 3=Zipf, 4=Bucle, 5=Stride, 6=Aleatorio): ";
+        std::cin >> m;
+        AccessModel model = m >= 1 && m <= ACCESS_MODEL_COUNT ? (AccessModel)(m - 1)
+                                                              : AccessModel::SEQUENTIAL;
+        std::cout << "PID (0 = procesos que se creen después): "; std::cin >> pid;
+        if (pid != 0) {
+            if (trace.setProcessAccessModel(pid, model))
+                std::cout << "Proceso " << pid << " usa " << accessModelName(model) << ".\n";
+            else
+                std::cout << "Error: PID inexistente o terminado.\n";
+        } else {
+            AccessParams prm = sched->getAccessParams();
+            uint64_t seed;
+            if (model == AccessModel::WORKING_SET) {
+                std::cout << "Páginas de la ventana: "; std::cin >> prm.wsPages;
+                std::cout << "Accesos por fase: "; std::cin >> prm.phaseLength;
+            } else if (model == AccessModel::ZIPF) {
+                std::cout << "Exponente s en milésimas (1000 = 1.0): "; std::cin >> prm.zipfSkew;
+            } else if (model == AccessModel::LOOP) {
+                std::cout << "Páginas del bucle: "; std::cin >> prm.loopPages;
+                std::cout << "Vueltas por bloque: "; std::cin >> prm.loopIterations;
+            } else if (model == AccessModel::STRIDE) {
+                std::cout << "Salto entre accesos: "; std::cin >> prm.stride;
+            }
+            std::cout << "% de páginas escritas (bit M): "; std::cin >> prm.writePercent;
+            std::cout << "Semilla: "; std::cin >> seed;
+            trace.setAccessModel(model, prm, seed);
+            std::cout << "Modelo " << accessModelName(model) << " para los procesos nuevos.\n";
+        }
+    }
+    else if (opcion == 33) {
+        int m;
+        std::cout << "1=Grabar referencias (on/off), 2=Guardar grabación,\n"
+                  << "3=Comparar grabación con OPT, 4=Comparar archivo con OPT: ";
+        std::cin >> m;
+        std::vector<PageRef> fromFile;
+        const std::vector<PageRef> *refs = &mem->getRecordedReferences();
+        std::string path, error;
+        if (m == 1) {
+            bool on = !mem->isRecordingReferences();
+            if (!on) std::cout << "Grabación detenida: " << refs->size() << " referencias.\n";
+            mem->recordReferences(on);
+            if (on) std::cout << "Grabando cada acceso a memoria (opción 33 para detener).\n";
+        } else if (m == 2) {
+            std::cout << "Archivo: "; std::cin >> path;
+            if (saveReferenceString(path, *refs, &error))
+                std::cout << refs->size() << " referencias guardadas en " << path << ".\n";
+            else std::cout << "Error: " << error << "\n";
+        } else if (m == 3 || m == 4) {
+            if (m == 4) {
+                std::cout << "Archivo: "; std::cin >> path;
+                if (!loadReferenceString(path, fromFile, &error)) {
+                    std::cout << "Error: " << error << "\n";
+                    return;
+                }
+                refs = &fromFile;
+            }
+            int frames;
+            std::cout << "Marcos (0 = los actuales): "; std::cin >> frames;
+            showOptimalComparison(*refs, frames > 0 ? frames : mem->getNumFrames());
+        }
+    }
     else if (opcion != 0) {
         std::cout << "Opción inválida.\n";
     }
@@ -1,20 +1,28 @@
 #ifndef CLI_H
 #define CLI_H
 
-#include "../modules/cpu/Scheduler.h"
+#include "../modules/cpu/SchedulerPolicy.h"
 #include "../modules/mem/MemoryManager.h"
 #include "../modules/mem/HeapAllocator.h"
 #include "../modules/cpu/Synchronization.h"
+#include "../modules/trace/Trace.h"
+#include "../modules/timeline/Timeline.h"
 
 class CLI {
 private:
     MemoryManager* mem;
     ProducerConsumer* prodCons;
-    SchedulerRR* sched;
+    SchedulerCore* sched;
+    SchedPolicy policy;
     HeapAllocator* heap;
+    TraceRecorder trace;        // Entradas que modifican la simulación (grabables)
+    TimelineRecorder timeline;  // Línea de tiempo Chrome trace-event (opcional)
     
+    SimState currentState() const;
     void showMenu();
+    void askPriority(int pid);
     void handleOption(int opcion);
+    void stopTimeline();
     
 public:
     CLI();
@@ -0,0 +1,168 @@
+#include "LatencyHistogram.h"
+#include "../snapshot/SnapshotIO.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+// ========== HISTOGRAMA LOGARÍTMICO ==========
+
+LatencyHistogram::LatencyHistogram() { reset(); }
+
+void LatencyHistogram::reset() {
+    std::fill(counts, counts + BUCKETS, 0);
+    total = 0;
+    sum = 0;
+    minValue = INT_MAX;
+    maxValue = 0;
+}
+
+int LatencyHistogram::bucketOf(int v) {
+    if (v < LINEAR) return v;
+    int msb = SUB_BITS + 1;
+    while (msb < 30 && (v >> (msb + 1))) msb++;
+    int shift = msb - SUB_BITS;
+    return LINEAR + (shift - 1) * SUB_BUCKETS + ((v >> shift) - SUB_BUCKETS);
+}
+
+int LatencyHistogram::highestInBucket(int index) {
+    if (index < LINEAR) return index;
+    int shift = (index - LINEAR) / SUB_BUCKETS + 1;
+    long long sub = SUB_BUCKETS + (index - LINEAR) % SUB_BUCKETS;
+    return (int)std::min<long long>(((sub + 1) << shift) - 1, INT_MAX);
+}
+
+void LatencyHistogram::record(int v) {
+    v = std::max(v, 0);
+    counts[bucketOf(v)]++;
+    total++;
+    sum += v;
+    minValue = std::min(minValue, v);
+    maxValue = std::max(maxValue, v);
+}
+
+void LatencyHistogram::add(const LatencyHistogram &other) {
+    for (int i = 0; i < BUCKETS; i++) counts[i] += other.counts[i];
+    total += other.total;
+    sum += other.sum;
+    minValue = std::min(minValue, other.minValue);
+    maxValue = std::max(maxValue, other.maxValue);
+}
+
+uint64_t LatencyHistogram::count() const { return total; }
+
+int LatencyHistogram::percentile(double q) const {
+    if (total == 0) return 0;
+    // Rango del valor buscado: ceil(q% de total), al menos el primero
+    uint64_t rank = (uint64_t)std::ceil(std::min(std::max(q, 0.0), 100.0) / 100.0 * total);
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; i++) {
+        seen += counts[i];
+        if (seen >= rank) return std::min(highestInBucket(i), maxValue);
+    }
+    return maxValue;
+}
+
+int LatencyHistogram::min() const { return total ? minValue : 0; }
+int LatencyHistogram::max() const { return maxValue; }
+double LatencyHistogram::mean() const { return total ? (double)sum / total : 0.0; }
+
+void LatencyHistogram::save(SnapshotWriter &w) const {
+    w.put(total);
+    w.put(sum);
+    w.put(minValue);
+    w.put(maxValue);
+    uint32_t used = 0;
+    for (int i = 0; i < BUCKETS; i++) used += counts[i] != 0;
+    w.put(used);
+    for (int i = 0; i < BUCKETS; i++) {
+        if (!counts[i]) continue;
+        w.put<uint32_t>(i);
+        w.put(counts[i]);
+    }
+}
+
+bool LatencyHistogram::load(SnapshotReader &r) {
+    LatencyHistogram next;
+    uint32_t used;
+    if (!r.get(next.total) || !r.get(next.sum) || !r.get(next.minValue) ||
+        !r.get(next.maxValue) || !r.get(used) || used > (uint32_t)BUCKETS) return r.fail();
+    uint64_t seen = 0;
+    int last = -1;
+    for (uint32_t k = 0; k < used; k++) {
+        uint32_t i;
+        uint64_t c;
+        if (!r.get(i) || !r.get(c)) return false;
+        if ((int)i <= last || i >= (uint32_t)BUCKETS || c == 0) return r.fail();
+        next.counts[i] = c;
+        seen += c;
+        last = i;
+    }
+    if (seen != next.total) return r.fail();
+    *this = next;
+    return true;
+}
+
+// ========== LATENCIAS POR TIPO ==========
+
+static const char *const LATENCY_METRIC_NAMES[LATENCY_METRICS] = {"Retorno", "Espera", "Respuesta"};
+
+LatencyStats::LatencyStats() : hist(LATENCY_METRICS * PROC_TYPES) {}
+
+void LatencyStats::reset() {
+    for (LatencyHistogram &h : hist) h.reset();
+}
+
+void LatencyStats::record(const PCB &p, int now) {
+    int t = (int)p.type;
+    if (t < 0 || t >= PROC_TYPES) return;
+    at((int)LatencyMetric::TURNAROUND, t).record(p.turnaround);
+    at((int)LatencyMetric::WAITING, t).record(p.getWaitingTime(now));
+    // Terminado sin haber llegado a la CPU (kill): no tiene respuesta
+    if (p.firstRunTick >= 0)
+        at((int)LatencyMetric::RESPONSE, t).record(p.firstRunTick - p.arrivalTick);
+}
+
+const LatencyHistogram &LatencyStats::get(LatencyMetric m, ProcType type) const {
+    return at((int)m, (int)type);
+}
+
+LatencyHistogram LatencyStats::total(LatencyMetric m) const {
+    LatencyHistogram all;
+    for (int t = 0; t < PROC_TYPES; t++) all.add(at((int)m, t));
+    return all;
+}
+
+static void latencyRow(const char *metric, const char *type, const LatencyHistogram &h) {
+    std::cout << "│ " << std::left << std::setw(9) << metric << " │ " << std::setw(11) << type
+              << std::right << " │ " << std::setw(9) << h.count();
+    for (double q : {50.0, 90.0, 99.0, 99.9}) std::cout << " │ " << std::setw(7) << h.percentile(q);
+    std::cout << " │ " << std::setw(7) << h.max() << " │\n";
+}
+
+void LatencyStats::show() const {
+    std::cout << "\n┌───────────┬─────────────┬───────────┬─────────┬─────────┬─────────┬─────────┬─────────┐\n";
+    std::cout << "│ Latencia  │ Tipo        │  Procesos │     p50 │     p90 │     p99 │   p99.9 │     max │\n";
+    for (int m = 0; m < LATENCY_METRICS; m++) {
+        LatencyHistogram all = total((LatencyMetric)m);
+        if (all.count() == 0) continue;
+        std::cout << "├───────────┼─────────────┼───────────┼─────────┼─────────┼─────────┼─────────┼─────────┤\n";
+        for (int t = 0; t < PROC_TYPES; t++)
+            if (at(m, t).count() > 0) latencyRow(LATENCY_METRIC_NAMES[m], procTypeName((ProcType)t), at(m, t));
+        latencyRow(LATENCY_METRIC_NAMES[m], "TODOS", all);
+    }
+    std::cout << "└───────────┴─────────────┴───────────┴─────────┴─────────┴─────────┴─────────┴─────────┘\n";
+    std::cout << "  (ticks; percentiles con error relativo < 1.6 %)\n";
+}
+
+void LatencyStats::save(SnapshotWriter &w) const {
+    for (const LatencyHistogram &h : hist) h.save(w);
+}
+
+bool LatencyStats::load(SnapshotReader &r) {
+    for (LatencyHistogram &h : hist)
+        if (!h.load(r)) return false;
+    return true;
+}
@@ -0,0 +1,89 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <cstdint>
+#include <vector>
+#include "Process.h"
+
+class SnapshotWriter;
+class SnapshotReader;
+
+// ========== HISTOGRAMA LOGARÍTMICO ==========
+/**
+ * Histograma de latencias al estilo HDR con memoria fija.
+ * - Valores 0..127 exactos; desde 128 cada potencia de dos se divide en
+ *   64 sub-buckets, así el error relativo es menor a 1/64 (~1.6 %).
+ * - 1664 buckets cubren todo int: el tamaño no depende de cuántos
+ *   valores se registren.
+ * - Los percentiles devuelven el mayor valor equivalente del bucket,
+ *   acotado por el máximo exacto.
+ */
+class LatencyHistogram {
+public:
+    static const int SUB_BITS = 6;
+    static const int SUB_BUCKETS = 1 << SUB_BITS;
+    static const int LINEAR = 2 * SUB_BUCKETS;
+    static const int BUCKETS = LINEAR + (30 - SUB_BITS) * SUB_BUCKETS;
+
+private:
+    uint64_t counts[BUCKETS];
+    uint64_t total;
+    long long sum;
+    int minValue;
+    int maxValue;
+
+    static int bucketOf(int v);
+    static int highestInBucket(int index);
+
+public:
+    LatencyHistogram();
+
+    void reset();
+    void record(int v);
+    void add(const LatencyHistogram &other);
+
+    uint64_t count() const;
+    int percentile(double q) const;     // q en [0, 100]
+    int min() const;
+    int max() const;
+    double mean() const;
+
+    // Snapshot: sólo los buckets no vacíos
+    void save(SnapshotWriter &w) const;
+    bool load(SnapshotReader &r);
+};
+
+// ========== LATENCIAS POR TIPO DE PROCESO ==========
+enum class LatencyMetric { TURNAROUND, WAITING, RESPONSE };
+
+const int LATENCY_METRICS = 3;
+const int PROC_TYPES = (int)ProcType::WRITER + 1;
+
+/**
+ * Retorno, espera y respuesta (primer tick en CPU - llegada) de cada
+ * proceso terminado, separados por ProcType. Se actualiza al terminar el
+ * proceso, así sobrevive a reapTerminated() y no crece con la cantidad de
+ * procesos.
+ */
+class LatencyStats {
+private:
+    std::vector<LatencyHistogram> hist;     // [métrica][tipo], en el heap (~240 KB)
+
+    LatencyHistogram &at(int metric, int type) { return hist[metric * PROC_TYPES + type]; }
+    const LatencyHistogram &at(int metric, int type) const { return hist[metric * PROC_TYPES + type]; }
+
+public:
+    LatencyStats();
+
+    void reset();
+    void record(const PCB &p, int now);
+
+    const LatencyHistogram &get(LatencyMetric m, ProcType type) const;
+    LatencyHistogram total(LatencyMetric m) const;
+    void show() const;
+
+    void save(SnapshotWriter &w) const;
+    bool load(SnapshotReader &r);
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -1,10 +1,12 @@
 #include "Process.h"
+#include "../snapshot/SnapshotIO.h"
 
 // ========== IMPLEMENTACIÓN DE THREAD ==========
 Thread::Thread(int _tid, int _pid, int burst)
     : tid(_tid), parentPid(_pid), state(ThreadState::THREAD_NEW), 
-      burstRemaining(burst), waitingTime(0),
-      itemsProduced(0), itemsConsumed(0), blockedOnSemaphore(-1) {}
+      burstRemaining(burst), waitingTime(0), waitMark(0),
+      itemsProduced(0), itemsConsumed(0), blockedOnSemaphore(-1), waiterId(-1),
+      prevReady(0), nextReady(0) {}
 
 std::string Thread::getStateString() const {
     switch (state) {
@@ -17,13 +19,31 @@ std::string Thread::getStateString() const {
     }
 }
 
+static bool threadAccruesWait(ThreadState s) {
+    return s == ThreadState::THREAD_READY || s == ThreadState::THREAD_WAITING;
+}
+
+void Thread::setState(ThreadState next, int threadClock) {
+    bool was = threadAccruesWait(state), will = threadAccruesWait(next);
+    if (was && !will) waitingTime += threadClock - waitMark;
+    else if (!was && will) waitMark = threadClock;
+    state = next;
+}
+
+int Thread::getWaitingTime(int threadClock) const {
+    return threadAccruesWait(state) ? waitingTime + (threadClock - waitMark) : waitingTime;
+}
+
 // ========== IMPLEMENTACIÓN DE PCB ==========
 PCB::PCB(int _id, int burst, int arrival, int pages)
     : id(_id), state(ProcState::NEW), type(ProcType::NORMAL), burstRemaining(burst),
-      arrivalTick(arrival), finishTick(-1), waitingTime(0), turnaround(0),
-      numPages(pages), nextPageToAccess(0), pageAccesses(0), pageFaults(0),
-      itemsProduced(0), itemsConsumed(0), blockedOnSemaphore(-1),
-      hasThreads(false), nextThreadId(1) {}
+      arrivalTick(arrival), finishTick(-1), waitingTime(0), waitSince(arrival), turnaround(0),
+      firstRunTick(-1), numPages(pages), nextPageToAccess(0), pageAccesses(0), pageFaults(0),
+      itemsProduced(0), itemsConsumed(0), blockedOnSemaphore(-1), waiterId(-1),
+      timerId(-1), level(0), affinity(~0ULL), cpuTime(0), readyTime(0), readySince(arrival),
+      nice(0), weight(1024), vruntime(0), period(0), relDeadline(0), wcet(0),
+      jobRelease(arrival), absDeadline(-1), hasThreads(false), nextThreadId(1), threadClock(0),
+      liveThreads(0), runningThreads(0), readyHead(0), readyTail(0) {}
 
 std::string PCB::getStateString() const {
     switch (state) {
@@ -37,7 +57,7 @@ std::string PCB::getStateString() const {
     }
 }
 
-std::string PCB::getTypeString() const {
+const char *procTypeName(ProcType type) {
     switch (type) {
         case ProcType::NORMAL: return "NORMAL";
         case ProcType::PRODUCER: return "PRODUCER";
@@ -49,6 +69,119 @@ std::string PCB::getTypeString() const {
     }
 }
 
+std::string PCB::getTypeString() const { return procTypeName(type); }
+
+static bool procAccruesWait(ProcState s) {
+    return s == ProcState::READY || s == ProcState::WAITING;
+}
+
+// 'now' es el último tick ya contabilizado: un proceso que entra en
+// READY/WAITING en el tick T empieza a esperar desde el tick T+1.
+void PCB::setState(ProcState next, int now) {
+    bool was = procAccruesWait(state), will = procAccruesWait(next);
+    if (was && !will) waitingTime += now - waitSince;
+    else if (!was && will) waitSince = now;
+    if (state == ProcState::READY && next != ProcState::READY) readyTime += now - readySince;
+    else if (state != ProcState::READY && next == ProcState::READY) readySince = now;
+    if (next == ProcState::RUNNING && firstRunTick < 0) firstRunTick = now;
+    state = next;
+}
+
+int PCB::getReadyTime(int now) const {
+    return state == ProcState::READY ? readyTime + (now - readySince) : readyTime;
+}
+
+int PCB::getWaitingTime(int now) const {
+    return procAccruesWait(state) ? waitingTime + (now - waitSince) : waitingTime;
+}
+
+// ========== HILOS DEL PCB ==========
+// Los TID son secuenciales desde 1 y nunca se eliminan: threads[tid - 1]
+
+static bool threadRunnable(ThreadState s) {
+    return s == ThreadState::THREAD_READY || s == ThreadState::THREAD_RUNNING;
+}
+
+int PCB::addThread(int burst) {
+    int tid = nextThreadId++;
+    threads.push_back(Thread(tid, id, burst));
+    hasThreads = true;
+    liveThreads++;
+    setThreadState(threads.back(), ThreadState::THREAD_READY);
+    return tid;
+}
+
+Thread &PCB::thread(int tid) { return threads[tid - 1]; }
+
+void PCB::setThreadState(Thread &t, ThreadState next) {
+    bool was = threadRunnable(t.state), will = threadRunnable(next);
+    if (!was && will) {
+        // Al final de la lista: los despertados esperan detrás de los listos
+        t.prevReady = readyTail;
+        t.nextReady = 0;
+        if (readyTail) thread(readyTail).nextReady = t.tid;
+        else readyHead = t.tid;
+        readyTail = t.tid;
+    } else if (was && !will) {
+        if (t.prevReady) thread(t.prevReady).nextReady = t.nextReady;
+        else readyHead = t.nextReady;
+        if (t.nextReady) thread(t.nextReady).prevReady = t.prevReady;
+        else readyTail = t.prevReady;
+        t.prevReady = t.nextReady = 0;
+    }
+    if (t.state == ThreadState::THREAD_RUNNING) runningThreads--;
+    if (next == ThreadState::THREAD_RUNNING) runningThreads++;
+    if (next == ThreadState::THREAD_TERMINATED && t.state != ThreadState::THREAD_TERMINATED)
+        liveThreads--;
+    t.setState(next, threadClock);
+}
+
+Thread *PCB::firstRunnableThread() { return readyHead ? &thread(readyHead) : nullptr; }
+
+bool PCB::hasRunnableThread() const { return readyHead != 0; }
+
+// ========== SNAPSHOT ==========
+// Campos escalares en orden de declaración; los hilos son triviales y se
+// copian como un bloque. timerId no se guarda: el planificador lo vuelve a
+// enlazar al cargar sus temporizadores.
+
+template <class Stream, class Pcb>
+static bool pcbFields(Stream &&field, Pcb &p) {
+    return field(p.id) && field(p.state) && field(p.type) && field(p.burstRemaining) &&
+           field(p.arrivalTick) && field(p.finishTick) && field(p.waitingTime) &&
+           field(p.waitSince) && field(p.turnaround) && field(p.firstRunTick) && field(p.numPages) &&
+           field(p.nextPageToAccess) && field(p.access.rng) && field(p.access.base) &&
+           field(p.access.left) && field(p.access.model) && field(p.pageAccesses) && field(p.pageFaults) &&
+           field(p.itemsProduced) && field(p.itemsConsumed) && field(p.blockedOnSemaphore) &&
+           field(p.waiterId) && field(p.level) && field(p.affinity) && field(p.cpuTime) &&
+           field(p.readyTime) && field(p.readySince) && field(p.nice) && field(p.weight) &&
+           field(p.vruntime) && field(p.period) && field(p.relDeadline) && field(p.wcet) &&
+           field(p.jobRelease) && field(p.absDeadline) && field(p.hasThreads) &&
+           field(p.nextThreadId) && field(p.threadClock) && field(p.liveThreads) &&
+           field(p.runningThreads) && field(p.readyHead) && field(p.readyTail);
+}
+
+void PCB::save(SnapshotWriter &w) const {
+    pcbFields([&w](const auto &v) { w.put(v); return true; }, *this);
+    w.putVector(threads);
+}
+
+bool PCB::load(SnapshotReader &r) {
+    if (!pcbFields([&r](auto &v) { return r.get(v); }, *this)) return false;
+    timerId = -1;
+    if ((int)access.model >= ACCESS_MODEL_COUNT || numPages < 1) return r.fail();
+    if (!r.getVector(threads)) return false;
+    // Los TID indexan el vector y enlazan la lista de ejecutables
+    int n = threads.size();
+    for (int i = 0; i < n; i++) {
+        const Thread &t = threads[i];
+        if (t.tid != i + 1 || t.prevReady < 0 || t.prevReady > n ||
+            t.nextReady < 0 || t.nextReady > n) return r.fail();
+    }
+    if (readyHead < 0 || readyHead > n || readyTail < 0 || readyTail > n) return r.fail();
+    return true;
+}
+
 bool PCB::isTerminated() const { return state == ProcState::TERMINATED; }
 bool PCB::isReady() const { return state == ProcState::READY; }
 bool PCB::isRunning() const { return state == ProcState::RUNNING; }
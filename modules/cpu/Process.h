@@ -3,15 +3,22 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
+#include "../mem/AccessModel.h"
+
+class SnapshotWriter;
+class SnapshotReader;
 
 // ========== ESTADOS Y TIPOS ==========
 enum class ProcState { NEW, READY, RUNNING, WAITING, SUSPENDED, TERMINATED };
 enum class ProcType { NORMAL, PRODUCER, CONSUMER, PHILOSOPHER, READER, WRITER };
 enum class ThreadState { THREAD_NEW, THREAD_READY, THREAD_RUNNING, THREAD_WAITING, THREAD_TERMINATED };
 
+const char *procTypeName(ProcType type);
+
 // ========== CONSTANTES ==========
 const int DEFAULT_QUANTUM = 3;
-const int MAX_THREADS_PER_PROCESS = 4;
+const int DEFAULT_THREAD_LIMIT = 4096;     // Hilos por proceso (configurable en el planificador)
 
 // ========== ESTRUCTURA DE HILO ==========
 struct Thread {
@@ -19,13 +26,21 @@ struct Thread {
     int parentPid;              // PID del proceso padre
     ThreadState state;
     int burstRemaining;
-    int waitingTime;
+    int waitingTime;            // Espera acumulada hasta waitMark
+    int waitMark;               // threadClock del PCB al entrar en READY/WAITING
     int itemsProduced;
     int itemsConsumed;
     int blockedOnSemaphore;
+    int waiterId;               // ID en la cola del semáforo (-1 = no bloqueado)
+    int prevReady;              // Lista intrusiva de ejecutables del PCB (TID, 0 = ninguno)
+    int nextReady;
 
     Thread(int _tid=0, int _pid=0, int burst=0);
     std::string getStateString() const;
+    
+    // Contabilidad perezosa: la espera se deriva del reloj de hilos del PCB
+    void setState(ThreadState next, int threadClock);
+    int getWaitingTime(int threadClock) const;
 };
 
 // ========== PCB (Process Control Block) ==========
@@ -36,23 +51,64 @@ struct PCB {
     int burstRemaining;
     int arrivalTick;
     int finishTick;
-    int waitingTime;
+    int waitingTime;            // Espera acumulada hasta waitSince
+    int waitSince;              // Tick en que entró en READY/WAITING
     int turnaround;
+    int firstRunTick;           // Primer tick en RUNNING (-1 = aún no) -> tiempo de respuesta
     int numPages;
     int nextPageToAccess;
+    AccessStream access;        // Modelo de referencias (qué página sigue)
     int pageAccesses;
     int pageFaults;
     int itemsProduced;
     int itemsConsumed;
     int blockedOnSemaphore;
+    int waiterId;               // ID en la cola del semáforo (-1 = no bloqueado)
+    int timerId;                // Llegada o sleep en la rueda de temporizadores (-1 = ninguno)
+    int level;                  // Nivel de prioridad MLFQ (0 = el más alto)
+    uint64_t affinity;          // CPUs permitidas en modo SMP (bit i = CPU i)
+    int cpuTime;                // Ticks en CPU
+    int readyTime;              // Ticks en READY hasta readySince
+    int readySince;             // Tick en que entró en READY
+    int nice;                   // -20 (más prioridad) .. 19
+    int weight;                 // Peso CFS derivado de nice (1024 = nice 0)
+    long long vruntime;         // Tiempo virtual CFS (ponderado por peso)
+    int period;                 // Tarea periódica: ticks entre activaciones (0 = aperiódica)
+    int relDeadline;            // Plazo relativo a cada activación (<= period)
+    int wcet;                   // Peor tiempo de ejecución: burst de cada trabajo
+    int jobRelease;             // Tick de activación del trabajo actual
+    int absDeadline;            // Plazo absoluto del trabajo actual
     
     // Soporte de hilos
     bool hasThreads;
     std::vector<Thread> threads;
     int nextThreadId;
+    int threadClock;            // Ticks en que un hilo avanzó (espera de hilos)
+    int liveThreads;            // Hilos no terminados
+    int runningThreads;         // Hilos en THREAD_RUNNING
+    int readyHead;              // Hilos READY/RUNNING en orden de llegada (TID, 0 = vacía)
+    int readyTail;
 
     PCB(int _id=0, int burst=0, int arrival=0, int pages=4);
     
+    // Contabilidad perezosa: registra el tick de cada transición y
+    // deriva el tiempo de espera (READY/WAITING) bajo demanda
+    void setState(ProcState next, int now);
+    int getWaitingTime(int now) const;
+    int getReadyTime(int now) const;
+    
+    // Hilos: toda transición pasa por aquí para mantener la lista de
+    // ejecutables y los contadores en O(1)
+    int addThread(int burst);
+    Thread &thread(int tid);
+    void setThreadState(Thread &t, ThreadState next);
+    Thread *firstRunnableThread();
+    bool hasRunnableThread() const;
+    
+    // Snapshot binario (hilos incluidos)
+    void save(SnapshotWriter &w) const;
+    bool load(SnapshotReader &r);
+    
     std::string getStateString() const;
     std::string getTypeString() const;
     bool isTerminated() const;
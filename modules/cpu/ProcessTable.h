@@ -0,0 +1,142 @@
+#ifndef PROCESS_TABLE_H
+#define PROCESS_TABLE_H
+
+#include <vector>
+#include <cstdint>
+#include "Process.h"
+#include "../snapshot/SnapshotIO.h"
+
+// ========== TABLA DE PROCESOS (SLOT MAP) ==========
+/**
+ * Tabla de procesos densa con slots generacionales.
+ *
+ * - Los PCB viven contiguos en un vector (sin nodos de árbol).
+ * - El PID codifica (generación, slot): búsqueda O(1) sin índice auxiliar.
+ *   Con generación 0 los PIDs son 1, 2, 3... como antes.
+ * - Al liberar un slot su generación avanza, así un PID viejo nunca
+ *   resuelve al proceso que reutilice ese slot.
+ * - La memoria es proporcional a los procesos vivos, no a los creados.
+ */
+class ProcessTable {
+private:
+    static const int SLOT_BITS = 24;                  // hasta 16M procesos vivos
+    static const int SLOT_MASK = (1 << SLOT_BITS) - 1;
+    static const int GEN_MASK = 0x7F;                 // PID siempre positivo
+
+    std::vector<PCB> slots;
+    std::vector<uint8_t> generation;
+    std::vector<uint8_t> live;
+    std::vector<int> freeSlots;
+    int liveCount;
+
+    int slotOf(int pid) const { return (pid & SLOT_MASK) - 1; }
+    int genOf(int pid) const { return (pid >> SLOT_BITS) & GEN_MASK; }
+
+public:
+    ProcessTable() : liveCount(0) {}
+
+    // Reserva un slot y devuelve el PID estable asociado
+    int allocate() {
+        int slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = slots.size();
+            slots.emplace_back();
+            generation.push_back(0);
+            live.push_back(0);
+        }
+        live[slot] = 1;
+        liveCount++;
+        return (generation[slot] << SLOT_BITS) | (slot + 1);
+    }
+
+    PCB *find(int pid) {
+        int slot = slotOf(pid);
+        if (pid <= 0 || slot < 0 || slot >= (int)slots.size()) return nullptr;
+        if (!live[slot] || generation[slot] != genOf(pid)) return nullptr;
+        return &slots[slot];
+    }
+
+    const PCB *find(int pid) const {
+        return const_cast<ProcessTable *>(this)->find(pid);
+    }
+
+    // Acceso directo cuando el PID es conocido y válido
+    PCB &at(int pid) { return slots[slotOf(pid)]; }
+    const PCB &at(int pid) const { return slots[slotOf(pid)]; }
+
+    bool erase(int pid) {
+        if (!find(pid)) return false;
+        int slot = slotOf(pid);
+        live[slot] = 0;
+        generation[slot] = (generation[slot] + 1) & GEN_MASK;
+        slots[slot] = PCB();
+        freeSlots.push_back(slot);
+        liveCount--;
+        return true;
+    }
+
+    void reserve(int n) {
+        slots.reserve(n);
+        generation.reserve(n);
+        live.reserve(n);
+    }
+
+    int size() const { return liveCount; }
+
+    // Snapshot: slots con su generación; los PCB sólo de los slots vivos
+    void save(SnapshotWriter &w) const {
+        w.putVector(generation);
+        w.putVector(live);
+        for (size_t i = 0; i < slots.size(); i++)
+            if (live[i]) slots[i].save(w);
+        w.putVector(freeSlots);
+    }
+
+    bool load(SnapshotReader &r) {
+        ProcessTable next;
+        if (!r.getVector(next.generation) || !r.getVector(next.live)) return false;
+        size_t n = next.generation.size();
+        if (next.live.size() != n) return r.fail();
+        next.slots.resize(n);
+        for (size_t i = 0; i < n; i++) {
+            if (!next.live[i]) continue;
+            if (!next.slots[i].load(r)) return false;
+            next.liveCount++;
+        }
+        if (!r.getVector(next.freeSlots)) return false;
+        for (int slot : next.freeSlots)
+            if (slot < 0 || slot >= (int)n || next.live[slot]) return r.fail();
+        *this = std::move(next);
+        return true;
+    }
+
+    // ========== ITERACIÓN (sólo slots vivos, en orden de slot) ==========
+    template <typename T, typename Table>
+    class Iter {
+    private:
+        Table *table;
+        int slot;
+        void skip() {
+            while (slot < (int)table->slots.size() && !table->live[slot]) slot++;
+        }
+    public:
+        Iter(Table *t, int s) : table(t), slot(s) { skip(); }
+        T &operator*() const { return table->slots[slot]; }
+        T *operator->() const { return &table->slots[slot]; }
+        Iter &operator++() { slot++; skip(); return *this; }
+        bool operator!=(const Iter &o) const { return slot != o.slot; }
+    };
+
+    typedef Iter<PCB, ProcessTable> iterator;
+    typedef Iter<const PCB, const ProcessTable> const_iterator;
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, slots.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, slots.size()); }
+};
+
+#endif // PROCESS_TABLE_H
@@ -1,303 +1,338 @@
-#include "Scheduler.h"
+#include "SchedulerEngine.h"
+#include "../timeline/Timeline.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
+#include <climits>
+#include <memory>
+
+// ========== NÚCLEO COMÚN - IMPLEMENTACIÓN ==========
+
+SchedulerCore::SchedulerCore(MemoryManager &mm, ProducerConsumer &pc)
+    : globalTick(0), runningPid(-1), quantumUsed(0),
+      memManager(mm), prodCons(pc), eventDriven(true), waitTimeout(0),
+      accessModel(AccessModel::SEQUENTIAL), accessSeed(1),
+      threadLimit(DEFAULT_THREAD_LIMIT), timeline(nullptr) {}
+
+bool SchedulerCore::shouldPreempt(const PCB &) { return false; }
+void SchedulerCore::readyWorkChanged(int) {}
+void SchedulerCore::quantumExpired(PCB &) {}
+void SchedulerCore::threadReady(PCB &, int) {}
+void SchedulerCore::dequeueReady(int) {}
+void SchedulerCore::accountRuntime(PCB &, int) {}
+bool SchedulerCore::jobCompleted(PCB &) { return false; }
+int SchedulerCore::nextTimer() const { return INT_MAX; }
+void SchedulerCore::onTimer() {}
+
+void SchedulerCore::fireTimer() { fireTimerImpl(*this); }
+
+int SchedulerCore::createProcess(int burst, int pages, ProcType type) {
+    int pid = processes.allocate();
+    PCB &pcb = processes.at(pid);
+    pcb = PCB(pid, burst, globalTick, pages);
+    pcb.setState(ProcState::READY, globalTick);
+    pcb.type = type;
+    pcb.nextPageToAccess = pcb.access.reset(accessModel, accessSeedFor(accessSeed, pid),
+                                            pages, accessParams);
+    enqueueReady(pid);
+    if (timeline) timeline->processCreated(globalTick, pid, type);
+    return pid;
+}
 
-// ========== SCHEDULER ROUND ROBIN - IMPLEMENTACIÓN ==========
-
-SchedulerRR::SchedulerRR(MemoryManager &mm, ProducerConsumer &pc, int q)
-    : quantum(q), globalTick(0), nextPid(1), runningPid(-1), quantumUsed(0),
-      memManager(mm), prodCons(pc) {}
-
-int SchedulerRR::createProcess(int burst, int pages, ProcType type) {
-    int pid = nextPid++;
-    PCB pcb(pid, burst, globalTick, pages);
-    pcb.state = ProcState::READY;
+int SchedulerCore::scheduleProcess(int arrivalTick, int burst, int pages, ProcType type) {
+    if (arrivalTick <= globalTick) return createProcess(burst, pages, type);
+    // NEW no acumula espera: el PCB cuenta desde su llegada
+    int pid = processes.allocate();
+    PCB &pcb = processes.at(pid);
+    pcb = PCB(pid, burst, arrivalTick, pages);
     pcb.type = type;
-    processes[pid] = pcb;
-    readyQueue.push(pid);
+    pcb.nextPageToAccess = pcb.access.reset(accessModel, accessSeedFor(accessSeed, pid),
+                                            pages, accessParams);
+    pcb.timerId = timers.add(globalTick, arrivalTick, TimerKind::ARRIVAL, pid);
     return pid;
 }
 
-int SchedulerRR::createThreadInProcess(int pid, int burstPerThread) {
-    auto it = processes.find(pid);
-    if (it == processes.end()) return -1;
+int SchedulerCore::createThreadInProcess(int pid, int burstPerThread) {
+    PCB *pp = processes.find(pid);
+    if (!pp) return -1;
     
-    PCB &p = it->second;
-    if (p.threads.size() >= MAX_THREADS_PER_PROCESS) return -1;
+    PCB &p = *pp;
+    if ((int)p.threads.size() >= threadLimit) return -1;
     
-    int tid = p.nextThreadId++;
-    Thread t(tid, pid, burstPerThread);
-    t.state = ThreadState::THREAD_READY;
-    p.threads.push_back(t);
-    p.hasThreads = true;
+    int tid = p.addThread(burstPerThread);
+    
+    // Un hilo nuevo listo vuelve ejecutable a un proceso bloqueado (no a uno dormido)
+    if (p.state == ProcState::WAITING && p.timerId == -1) {
+        p.setState(ProcState::READY, globalTick);
+        enqueueReady(pid);
+    } else if (p.state == ProcState::READY) {
+        readyWorkChanged(pid);
+    } else if (p.state == ProcState::RUNNING) {
+        threadReady(p, tid);
+    }
     
     return tid;
 }
 
-void SchedulerRR::executeThreadTick(PCB &p) {
-    // Buscar primer thread READY o RUNNING
-    Thread *activeThread = nullptr;
+int SchedulerCore::createPeriodicTask(int, int, int, int) { return -1; }
+
+int SchedulerCore::syncOperation(PCB &p, int tid, int &waiterId) {
+    // Reservar un ID de waiter por si la operación queda bloqueada
+    if (!freeWaiterIds.empty()) {
+        waiterId = freeWaiterIds.back();
+        freeWaiterIds.pop_back();
+        waiterRefs[waiterId] = {p.id, tid};
+    } else {
+        waiterId = waiterRefs.size();
+        waiterRefs.push_back({p.id, tid});
+        waiterTimers.push_back(-1);
+    }
+
+    int item = p.id;
+    int result = (p.type == ProcType::PRODUCER) ? prodCons.tryProduce(waiterId, item)
+                                                : prodCons.tryConsume(waiterId, item);
+    if (result == 0) {
+        freeWaiterIds.push_back(waiterId);
+        waiterId = -1;
+    } else if (waitTimeout > 0) {
+        waiterTimers[waiterId] = timers.add(globalTick, globalTick + waitTimeout,
+                                            TimerKind::TIMEOUT, p.id, waiterId);
+    }
+    return result;
+}
+
+void SchedulerCore::clearWaitTimeout(int waiterId) {
+    if (waiterTimers[waiterId] == -1) return;
+    timers.cancel(waiterTimers[waiterId]);
+    waiterTimers[waiterId] = -1;
+}
+
+void SchedulerCore::cancelWaits(PCB &p) {
+    if (p.waiterId != -1) {
+        prodCons.cancel(p.waiterId);
+        clearWaitTimeout(p.waiterId);
+        freeWaiterIds.push_back(p.waiterId);
+        p.waiterId = -1;
+    }
     for (auto &t : p.threads) {
-        if (t.state == ThreadState::THREAD_READY || t.state == ThreadState::THREAD_RUNNING) {
-            activeThread = &t;
-            break;
+        if (t.waiterId != -1) {
+            prodCons.cancel(t.waiterId);
+            clearWaitTimeout(t.waiterId);
+            freeWaiterIds.push_back(t.waiterId);
+            t.waiterId = -1;
         }
     }
+}
+
+bool SchedulerCore::hasRunnableThread(const PCB &p) const {
+    return p.hasRunnableThread();
+}
 
+void SchedulerCore::executeThreadTick(PCB &p) {
+    // El hilo activo es el primero de la lista de ejecutables del PCB
+    Thread *activeThread = p.firstRunnableThread();
     if (!activeThread) return;
 
-    activeThread->state = ThreadState::THREAD_RUNNING;
+    p.setThreadState(*activeThread, ThreadState::THREAD_RUNNING);
     activeThread->burstRemaining--;
+    if (timeline) timeline->running(globalTick, p.id, activeThread->tid);
 
     // Lógica según tipo de proceso
-    if (p.type == ProcType::PRODUCER) {
-        int item;
-        int result = prodCons.tryProduce(p.id, item);
+    if (p.type == ProcType::PRODUCER || p.type == ProcType::CONSUMER) {
+        int waiterId;
+        int result = syncOperation(p, activeThread->tid, waiterId);
         if (result == 0) {
-            activeThread->itemsProduced++;
-            p.itemsProduced++;
-        } else {
-            activeThread->state = ThreadState::THREAD_WAITING;
-            activeThread->blockedOnSemaphore = result - 1;
-            return;
-        }
-    } else if (p.type == ProcType::CONSUMER) {
-        int item;
-        int result = prodCons.tryConsume(p.id, item);
-        if (result == 0) {
-            activeThread->itemsConsumed++;
-            p.itemsConsumed++;
+            if (p.type == ProcType::PRODUCER) {
+                activeThread->itemsProduced++;
+                p.itemsProduced++;
+            } else {
+                activeThread->itemsConsumed++;
+                p.itemsConsumed++;
+            }
+            if (timeline) timeline->item(globalTick, p.id, activeThread->tid, p.type == ProcType::PRODUCER);
         } else {
-            activeThread->state = ThreadState::THREAD_WAITING;
+            p.setThreadState(*activeThread, ThreadState::THREAD_WAITING);
             activeThread->blockedOnSemaphore = result - 1;
+            activeThread->waiterId = waiterId;
+            if (timeline) timeline->block(globalTick, p.id, activeThread->tid, result - 1);
+            // Sin otros hilos ejecutables el proceso completo se bloquea
+            if (!hasRunnableThread(p)) p.setState(ProcState::WAITING, globalTick);
             return;
         }
     }
 
-    // Actualizar waiting time de otros threads
-    for (auto &t : p.threads) {
-        if (t.tid != activeThread->tid && 
-            (t.state == ThreadState::THREAD_READY || t.state == ThreadState::THREAD_WAITING)) {
-            t.waitingTime++;
-        }
-    }
+    // Los demás hilos READY/WAITING suman un tick de espera (se deriva de threadClock)
+    p.threadClock++;
 
     // Check si thread terminó
     if (activeThread->burstRemaining <= 0) {
-        activeThread->state = ThreadState::THREAD_TERMINATED;
-        
-        // Verificar si todos los threads terminaron
-        bool allDone = true;
-        for (auto &t : p.threads) {
-            if (t.state != ThreadState::THREAD_TERMINATED) {
-                allDone = false;
-                break;
-            }
-        }
+        p.setThreadState(*activeThread, ThreadState::THREAD_TERMINATED);
         
-        if (allDone) {
+        if (p.liveThreads == 0) {
             p.burstRemaining = 0;
+        } else if (!hasRunnableThread(p)) {
+            // Los hilos restantes están bloqueados
+            p.setState(ProcState::WAITING, globalTick);
         }
     } else {
-        // Round-robin entre threads
-        activeThread->state = ThreadState::THREAD_READY;
+        // Sigue al frente de la lista mientras sea ejecutable
+        p.setThreadState(*activeThread, ThreadState::THREAD_READY);
     }
 }
 
-void SchedulerRR::unblockWaitingProcesses() {
-    // Desbloquear procesos esperando en semáforos
-    for (auto &kv : processes) {
-        PCB &p = kv.second;
-        
-        // Desbloquear procesos sin hilos
-        if (!p.hasThreads && p.state == ProcState::WAITING) {
-            // Reintentar la operación que falló
-            bool unblocked = false;
-            
-            if (p.type == ProcType::PRODUCER) {
-                int item;
-                int result = prodCons.tryProduce(p.id, item);
-                if (result == 0) {
-                    p.itemsProduced++;
-                    p.state = ProcState::READY;
-                    p.blockedOnSemaphore = -1;
-                    readyQueue.push(p.id);
-                    unblocked = true;
-                }
-            } else if (p.type == ProcType::CONSUMER) {
-                int item;
-                int result = prodCons.tryConsume(p.id, item);
-                if (result == 0) {
-                    p.itemsConsumed++;
-                    p.state = ProcState::READY;
-                    p.blockedOnSemaphore = -1;
-                    readyQueue.push(p.id);
-                    unblocked = true;
-                }
-            }
-        }
-        
-        // Desbloquear threads en procesos con hilos
-        if (p.hasThreads) {
-            for (auto &t : p.threads) {
-                if (t.state == ThreadState::THREAD_WAITING) {
-                    bool unblocked = false;
-                    
-                    if (p.type == ProcType::PRODUCER) {
-                        int item;
-                        int result = prodCons.tryProduce(p.id, item);
-                        if (result == 0) {
-                            t.itemsProduced++;
-                            p.itemsProduced++;
-                            t.state = ThreadState::THREAD_READY;
-                            t.blockedOnSemaphore = -1;
-                            unblocked = true;
-                        }
-                    } else if (p.type == ProcType::CONSUMER) {
-                        int item;
-                        int result = prodCons.tryConsume(p.id, item);
-                        if (result == 0) {
-                            t.itemsConsumed++;
-                            p.itemsConsumed++;
-                            t.state = ThreadState::THREAD_READY;
-                            t.blockedOnSemaphore = -1;
-                            unblocked = true;
-                        }
-                    }
-                    
-                    // Si desbloqueamos un thread y el proceso estaba WAITING, ponerlo READY
-                    if (unblocked && p.state == ProcState::WAITING) {
-                        p.state = ProcState::READY;
-                        readyQueue.push(p.id);
-                    }
-                }
-            }
-        }
-    }
+void SchedulerCore::unblockWaitingProcesses() { unblockWaitingProcessesImpl(*this); }
+
+void SchedulerCore::checkPreemption() { checkPreemptionImpl(*this); }
+
+void SchedulerCore::tick() { tickImpl(*this); }
+
+void SchedulerCore::runTicks(int n) { runTicksImpl(*this, n); }
+
+void SchedulerCore::runSlice(PCB &p, int ticks) { runSliceImpl(*this, p, ticks); }
+
+void SchedulerCore::finishBurst(PCB &p) { finishBurstImpl(*this, p); }
+
+void SchedulerCore::terminateProcess(PCB &p) {
+    // Una sola vez por PCB: las latencias cuentan procesos, no llamadas
+    if (p.state == ProcState::TERMINATED) return;
+    p.setState(ProcState::TERMINATED, globalTick);
+    p.finishTick = globalTick;
+    p.turnaround = p.finishTick - p.arrivalTick;
+    latency.record(p, globalTick);
+    memManager.freeFramesOfPid(p.id);
+    if (timeline) timeline->processExited(globalTick, p.id);
 }
 
-void SchedulerRR::tick() {
-    globalTick++;
-    if (runningPid == -1) scheduleNext();
-    for (auto &kv : processes) {
-        if (kv.second.state == ProcState::READY)
-            kv.second.waitingTime++;
-        else if (kv.second.state == ProcState::WAITING)
-            kv.second.waitingTime++;
-    }
+void SchedulerCore::setThreadLimit(int limit) { threadLimit = std::max(1, limit); }
+int SchedulerCore::getThreadLimit() const { return threadLimit; }
 
-    if (runningPid != -1) {
-        PCB &p = processes[runningPid];
-        p.state = ProcState::RUNNING;
-        quantumUsed++;
-        
-        // Acceso a memoria
-        bool pf = memManager.access(p.id, p.nextPageToAccess);
-        if (pf) p.pageFaults++;
-        p.pageAccesses++;
-        p.nextPageToAccess = (p.nextPageToAccess + 1) % p.numPages;
-
-        // Si el proceso tiene hilos, ejecutar lógica de threads
-        if (p.hasThreads) {
-            executeThreadTick(p);
-            
-            // Verificar si todos los threads terminaron
-            if (p.burstRemaining <= 0) {
-                p.state = ProcState::TERMINATED;
-                p.finishTick = globalTick;
-                p.turnaround = p.finishTick - p.arrivalTick;
-                memManager.freeFramesOfPid(p.id);
-                runningPid = -1;
-                quantumUsed = 0;
-            } else if (quantumUsed >= quantum) {
-                p.state = ProcState::READY;
-                readyQueue.push(p.id);
-                runningPid = -1;
-                quantumUsed = 0;
-            }
-        } else {
-            // Lógica sin threads (proceso normal)
-            p.burstRemaining--;
-            
-            // Lógica de productor-consumidor
-            if (p.type == ProcType::PRODUCER) {
-                int item;
-                int result = prodCons.tryProduce(p.id, item);
-                if (result == 0) {
-                    p.itemsProduced++;
-                } else {
-                    p.state = ProcState::WAITING;
-                    p.blockedOnSemaphore = result - 1;
-                    runningPid = -1;
-                    quantumUsed = 0;
-                    return;
-                }
-            } else if (p.type == ProcType::CONSUMER) {
-                int item;
-                int result = prodCons.tryConsume(p.id, item);
-                if (result == 0) {
-                    p.itemsConsumed++;
-                } else {
-                    p.state = ProcState::WAITING;
-                    p.blockedOnSemaphore = result - 1;
-                    runningPid = -1;
-                    quantumUsed = 0;
-                    return;
-                }
-            }
+void SchedulerCore::setEventDriven(bool enabled) { eventDriven = enabled; }
+bool SchedulerCore::isEventDriven() const { return eventDriven; }
 
-            if (p.burstRemaining <= 0) {
-                p.state = ProcState::TERMINATED;
-                p.finishTick = globalTick;
-                p.turnaround = p.finishTick - p.arrivalTick;
-                memManager.freeFramesOfPid(p.id);
-                runningPid = -1;
-                quantumUsed = 0;
-            } else if (quantumUsed >= quantum) {
-                p.state = ProcState::READY;
-                readyQueue.push(p.id);
-                runningPid = -1;
-                quantumUsed = 0;
-            }
-        }
+void SchedulerCore::setTimeline(TimelineRecorder *recorder) { timeline = recorder; }
+
+// ========== SNAPSHOT ==========
+// El motor de eventos no guarda estado entre llamadas a runTicks(): nada que guardar
+
+bool SchedulerCore::savePolicyState(SnapshotWriter &) const { return false; }
+bool SchedulerCore::loadPolicyState(SnapshotReader &) { return false; }
+
+bool SchedulerCore::saveState(SnapshotWriter &w) const {
+    w.put(globalTick);
+    w.put(runningPid);
+    w.put(quantumUsed);
+    w.put(eventDriven);
+    w.put(threadLimit);
+    w.put<uint64_t>(waiterRefs.size());
+    for (const auto &ref : waiterRefs) {
+        w.put(ref.first);
+        w.put(ref.second);
     }
-    
-    // DESBLOQUEO AUTOMÁTICO: intentar despertar procesos/threads bloqueados
-    unblockWaitingProcesses();
+    w.putVector(freeWaiterIds);
+    processes.save(w);
+    latency.save(w);
+    timers.save(w);
+    w.put(waitTimeout);
+    w.put(accessModel);
+    w.put(accessSeed);
+    w.put(accessParams.wsPages);
+    w.put(accessParams.phaseLength);
+    w.put(accessParams.zipfSkew);
+    w.put(accessParams.loopPages);
+    w.put(accessParams.loopIterations);
+    w.put(accessParams.stride);
+    w.put(accessParams.writePercent);
+    return savePolicyState(w);
 }
 
-void SchedulerRR::runTicks(int n) { 
-    for (int i=0;i<n;i++) tick(); 
+bool SchedulerCore::loadState(SnapshotReader &r) {
+    int tick, running, used, limit;
+    bool driven;
+    uint64_t refs;
+    if (!r.get(tick) || !r.get(running) || !r.get(used) || !r.get(driven) || !r.get(limit))
+        return false;
+    if (!r.getCount(refs, 2 * sizeof(int))) return false;
+    std::vector<std::pair<int, int>> nextRefs(refs);
+    for (auto &ref : nextRefs)
+        if (!r.get(ref.first) || !r.get(ref.second)) return false;
+    std::vector<int> nextFree;
+    ProcessTable nextTable;
+    if (!r.getVector(nextFree) || !nextTable.load(r)) return false;
+    if (running != -1 && !nextTable.find(running)) return r.fail();
+    std::unique_ptr<LatencyStats> nextLatency(new LatencyStats());
+    if (!nextLatency->load(r)) return false;
+
+    // Temporizadores: cada uno vuelve a enlazarse con su PCB o su waiter
+    std::unique_ptr<TimingWheel> nextTimers(new TimingWheel());
+    int timeout;
+    if (!nextTimers->load(r, tick) || !r.get(timeout)) return false;
+    std::vector<int> nextWaiterTimers(refs, -1);
+    bool linked = true;
+    nextTimers->forEach([&](int handle, const TimerEntry &e) {
+        if (e.kind == TimerKind::TIMEOUT) {
+            if (e.arg < 0 || e.arg >= (int)refs || nextWaiterTimers[e.arg] != -1) linked = false;
+            else nextWaiterTimers[e.arg] = handle;
+            return;
+        }
+        PCB *p = nextTable.find(e.pid);
+        if (!p || p->timerId != -1 || (e.kind == TimerKind::ARRIVAL) != (p->state == ProcState::NEW))
+            linked = false;
+        else p->timerId = handle;
+    });
+    if (!linked) return r.fail();
+
+    AccessModel model;
+    AccessParams params;
+    uint64_t seed;
+    if (!r.get(model) || !r.get(seed) || !r.get(params.wsPages) || !r.get(params.phaseLength) ||
+        !r.get(params.zipfSkew) || !r.get(params.loopPages) || !r.get(params.loopIterations) ||
+        !r.get(params.stride) || !r.get(params.writePercent))
+        return false;
+    if ((int)model >= ACCESS_MODEL_COUNT) return r.fail();
+
+    // La política valida y confirma lo suyo antes de tocar el núcleo
+    if (!loadPolicyState(r)) return false;
+    globalTick = tick;
+    runningPid = running;
+    quantumUsed = used;
+    eventDriven = driven;
+    threadLimit = limit;
+    waiterRefs = std::move(nextRefs);
+    freeWaiterIds = std::move(nextFree);
+    processes = std::move(nextTable);
+    latency = std::move(*nextLatency);
+    timers = *nextTimers;
+    waiterTimers = std::move(nextWaiterTimers);
+    waitTimeout = timeout;
+    setAccessModel(model, params, seed);
+    return true;
 }
 
-void SchedulerRR::scheduleNext() {
-    while(!readyQueue.empty() && processes[readyQueue.front()].state == ProcState::TERMINATED)
-        readyQueue.pop();
-    if (!readyQueue.empty()) {
-        int pid = readyQueue.front(); 
-        readyQueue.pop();
-        if (processes[pid].burstRemaining > 0) {
-            runningPid = pid;
-            quantumUsed = 0;
-        } else processes[pid].state = ProcState::TERMINATED;
+bool SchedulerCore::killProcess(int pid) {
+    PCB *p = processes.find(pid);
+    if (!p || p->state == ProcState::TERMINATED) return false;
+    cancelWaits(*p);
+    if (p->timerId != -1) {
+        timers.cancel(p->timerId);
+        p->timerId = -1;
     }
-}
-
-bool SchedulerRR::killProcess(int pid) {
-    auto it = processes.find(pid);
-    if (it == processes.end()) return false;
-    it->second.state = ProcState::TERMINATED;
-    it->second.finishTick = globalTick;
-    it->second.turnaround = it->second.finishTick - it->second.arrivalTick;
-    memManager.freeFramesOfPid(pid);
+    // Una llegada cancelada cuenta como llegada y terminada ahora
+    if (p->state == ProcState::NEW) p->arrivalTick = globalTick;
+    if (p->state == ProcState::READY) dequeueReady(pid);
+    // Si está corriendo, remover de ejecución
+    if (runningPid == pid) {
+        runningPid = -1;
+        quantumUsed = 0;
+    }
+    terminateProcess(*p);
     return true;
 }
 
-bool SchedulerRR::suspendProcess(int pid) {
-    auto it = processes.find(pid);
-    if (it == processes.end()) return false;
-    if (it->second.state == ProcState::TERMINATED || it->second.state == ProcState::SUSPENDED) 
+bool SchedulerCore::suspendProcess(int pid) {
+    PCB *p = processes.find(pid);
+    if (!p) return false;
+    if (p->state == ProcState::TERMINATED || p->state == ProcState::SUSPENDED ||
+        p->state == ProcState::NEW)
         return false;
     
     // Si está corriendo, remover de ejecución
@@ -305,28 +340,94 @@ bool SchedulerRR::suspendProcess(int pid) {
         runningPid = -1;
         quantumUsed = 0;
     }
+    if (p->state == ProcState::READY) dequeueReady(pid);
     
-    it->second.state = ProcState::SUSPENDED;
+    p->setState(ProcState::SUSPENDED, globalTick);
     return true;
 }
 
-bool SchedulerRR::resumeProcess(int pid) {
-    auto it = processes.find(pid);
-    if (it == processes.end()) return false;
-    if (it->second.state != ProcState::SUSPENDED) return false;
+bool SchedulerCore::resumeProcess(int pid) {
+    PCB *pp = processes.find(pid);
+    if (!pp) return false;
+    if (pp->state != ProcState::SUSPENDED) return false;
     
+    // Si sigue estacionado en un semáforo (o dormido) vuelve a WAITING
+    PCB &p = *pp;
+    bool blocked = p.hasThreads ? !hasRunnableThread(p) && p.burstRemaining > 0
+                                : p.waiterId != -1;
+    blocked |= p.timerId != -1;
+    if (blocked) {
+        p.setState(ProcState::WAITING, globalTick);
+        return true;
+    }
+
     // Pasar a READY y agregar a la cola
-    it->second.state = ProcState::READY;
-    readyQueue.push(pid);
+    p.setState(ProcState::READY, globalTick);
+    enqueueReady(pid);
+    return true;
+}
+
+bool SchedulerCore::sleepProcess(int pid, int ticks) {
+    PCB *pp = processes.find(pid);
+    if (!pp || ticks <= 0) return false;
+    PCB &p = *pp;
+    if (p.state != ProcState::READY && p.state != ProcState::RUNNING) return false;
+    if (runningPid == pid) {
+        runningPid = -1;
+        quantumUsed = 0;
+    }
+    if (p.state == ProcState::READY) dequeueReady(pid);
+    p.setState(ProcState::WAITING, globalTick);
+    p.timerId = timers.add(globalTick, globalTick + ticks, TimerKind::SLEEP, pid);
+    if (timeline) timeline->block(globalTick, pid, 0, -1);
+    return true;
+}
+
+void SchedulerCore::setWaitTimeout(int ticks) { waitTimeout = std::max(0, ticks); }
+int SchedulerCore::getWaitTimeout() const { return waitTimeout; }
+int SchedulerCore::pendingTimers() const { return timers.size(); }
+
+void SchedulerCore::setAccessModel(AccessModel model, const AccessParams &params, uint64_t seed) {
+    accessModel = model;
+    accessParams = params;
+    accessSeed = seed;
+}
+
+bool SchedulerCore::setProcessAccessModel(int pid, AccessModel model) {
+    PCB *p = processes.find(pid);
+    if (!p || p->state == ProcState::TERMINATED) return false;
+    p->nextPageToAccess = p->access.reset(model, accessSeedFor(accessSeed, pid),
+                                          p->numPages, accessParams);
+    return true;
+}
+
+AccessModel SchedulerCore::getAccessModel() const { return accessModel; }
+const AccessParams &SchedulerCore::getAccessParams() const { return accessParams; }
+uint64_t SchedulerCore::getAccessSeed() const { return accessSeed; }
+
+bool SchedulerCore::setPriority(int pid, int nice) {
+    PCB *p = processes.find(pid);
+    if (!p || p->state == ProcState::TERMINATED) return false;
+    p->nice = std::min(std::max(nice, -20), 19);
+    // Las políticas con clave de prioridad reordenan su cola
+    if (p->state == ProcState::READY) readyWorkChanged(pid);
     return true;
 }
 
-void SchedulerRR::listProcesses() const {
+int SchedulerCore::reapTerminated() {
+    // Libera los slots de los procesos terminados (sus PIDs dejan de ser válidos)
+    std::vector<int> dead;
+    for (const PCB &p : processes)
+        if (p.state == ProcState::TERMINATED && p.id != runningPid) dead.push_back(p.id);
+    for (int pid : dead) processes.erase(pid);
+    return dead.size();
+}
+
+void SchedulerCore::listProcesses() const {
     std::cout << "\n+-----+----------+----------+-------+---------+---------+----------+----------+---------+\n";
     std::cout << "| pid | tipo     | estado   | burst | waiting | pages   | prod/cons | blocked  | threads |\n";
     std::cout << "+-----+----------+----------+-------+---------+---------+----------+----------+---------+\n";
-    for (auto &kv : processes) {
-        const PCB &p = kv.second;
+    for (const PCB &p : processes) {
         std::string st, tp;
         switch (p.state) {
             case ProcState::NEW: st="NEW"; break;
@@ -346,13 +447,16 @@ void SchedulerRR::listProcesses() const {
         }
         std::string items = (p.type == ProcType::PRODUCER) ? std::to_string(p.itemsProduced) :
                            (p.type == ProcType::CONSUMER) ? std::to_string(p.itemsConsumed) : "-";
-        std::string blocked = (p.state == ProcState::WAITING) ? "Sem" + std::to_string(p.blockedOnSemaphore) : "-";
+        std::string blocked = (p.state != ProcState::WAITING) ? "-"
+                            : (p.period > 0 && p.burstRemaining == 0) ? "Period."
+                            : (p.timerId != -1) ? "Sleep"
+                            : "Sem" + std::to_string(p.blockedOnSemaphore);
         std::string threads = p.hasThreads ? std::to_string(p.threads.size()) : "-";
         
         std::cout << "| " << std::setw(3) << p.id << " | " << std::setw(8) << tp
                   << " | " << std::setw(8) << st
                   << " | " << std::setw(5) << p.burstRemaining
-                  << " | " << std::setw(7) << p.waitingTime
+                  << " | " << std::setw(7) << p.getWaitingTime(globalTick)
                   << " | " << std::setw(7) << p.numPages
                   << " | " << std::setw(8) << items
                   << " | " << std::setw(8) << blocked
@@ -361,14 +465,14 @@ void SchedulerRR::listProcesses() const {
     std::cout << "+-----+----------+----------+-------+---------+---------+----------+----------+---------+\n";
 }
 
-void SchedulerRR::showThreads(int pid) const {
-    auto it = processes.find(pid);
-    if (it == processes.end()) {
+void SchedulerCore::showThreads(int pid) const {
+    const PCB *pp = processes.find(pid);
+    if (!pp) {
         std::cout << "Proceso no encontrado.\n";
         return;
     }
 
-    const PCB &p = it->second;
+    const PCB &p = *pp;
     if (!p.hasThreads || p.threads.empty()) {
         std::cout << "El proceso " << pid << " no tiene hilos.\n";
         return;
@@ -403,7 +507,7 @@ void SchedulerRR::showThreads(int pid) const {
         std::cout << "│ " << std::setw(3) << t.tid
                   << " │ " << std::setw(12) << st
                   << " │ " << std::setw(5) << t.burstRemaining
-                  << " │ " << std::setw(7) << t.waitingTime
+                  << " │ " << std::setw(7) << t.getWaitingTime(p.threadClock)
                   << " │ " << std::setw(8) << items
                   << " │ " << std::setw(8) << blocked << " │\n";
     }
@@ -411,7 +515,7 @@ void SchedulerRR::showThreads(int pid) const {
     std::cout << "└─────┴──────────────┴───────┴─────────┴──────────┴──────────┘\n";
 }
 
-void SchedulerRR::showStats() const {
+void SchedulerCore::showStats() const {
     double avgWait = 0, avgTurn = 0, totalCpuTime = 0;
     int finished = 0, totalProduced = 0, totalConsumed = 0;
     int normalProcs = 0, producers = 0, consumers = 0;
@@ -427,13 +531,12 @@ void SchedulerRR::showStats() const {
     std::cout << "│ PID │   Tipo   │ Arrival │  Finish  │ Turnaround│  Waiting │   Prod/Cons  │\n";
     std::cout << "├─────┼──────────┼─────────┼──────────┼───────────┼──────────┼──────────────┤\n";
     
-    for (auto &kv : processes) {
-        const PCB &p = kv.second;
+    for (const PCB &p : processes) {
         if (p.state == ProcState::TERMINATED) {
             finished++;
-            avgWait += p.waitingTime;
+            avgWait += p.getWaitingTime(globalTick);
             avgTurn += p.turnaround;
-            totalCpuTime += (p.turnaround - p.waitingTime);
+            totalCpuTime += (p.turnaround - p.getWaitingTime(globalTick));
             
             std::string tipo;
             std::string items = "-";
@@ -458,7 +561,7 @@ void SchedulerRR::showStats() const {
                       << " │ " << std::setw(7) << p.arrivalTick
                       << " │ " << std::setw(8) << p.finishTick
                       << " │ " << std::setw(9) << p.turnaround
-                      << " │ " << std::setw(8) << p.waitingTime
+                      << " │ " << std::setw(8) << p.getWaitingTime(globalTick)
                       << " │ " << std::setw(12) << items << " │\n";
         }
     }
@@ -506,11 +609,14 @@ void SchedulerRR::showStats() const {
         std::cout << "└──────────────────────────────────────┴───────────────────────┘\n";
     }
     
+    // Percentiles: incluyen los procesos ya liberados con reapTerminated()
+    latency.show();
+    
     // Mostrar estadísticas de memoria
     memManager.showFrames();
 }
 
-void SchedulerRR::showDetailedReport() const {
+void SchedulerCore::showDetailedReport() const {
     std::cout << "\n╔═══════════════════════════════════════════════════════════════════╗\n";
     std::cout << "║              REPORTE COMPLETO DE TODOS LOS PROCESOS               ║\n";
     std::cout << "╚═══════════════════════════════════════════════════════════════════╝\n";
@@ -519,8 +625,7 @@ void SchedulerRR::showDetailedReport() const {
     std::cout << "│ PID │   Tipo   │  Estado  │Burst │ Waiting │ Pages │Faults│  Accesos │Prod/Con│\n";
     std::cout << "├─────┼──────────┼──────────┼──────┼─────────┼───────┼──────┼──────────┼────────┤\n";
     
-    for (auto &kv : processes) {
-        const PCB &p = kv.second;
+    for (const PCB &p : processes) {
         
         std::string tipo, estado;
         switch (p.type) {
@@ -547,7 +652,7 @@ void SchedulerRR::showDetailedReport() const {
                   << " │ " << std::setw(8) << tipo
                   << " │ " << std::setw(8) << estado
                   << " │ " << std::setw(4) << p.burstRemaining
-                  << " │ " << std::setw(7) << p.waitingTime
+                  << " │ " << std::setw(7) << p.getWaitingTime(globalTick)
                   << " │ " << std::setw(5) << p.numPages
                   << " │ " << std::setw(4) << p.pageFaults
                   << " │ " << std::setw(8) << p.pageAccesses
@@ -562,133 +667,210 @@ void SchedulerRR::showDetailedReport() const {
     std::cout << "└────────────────────────────────────────────────────────┘\n";
     
     int maxWait = 0;
-    for (auto &kv : processes) {
-        if (kv.second.state == ProcState::TERMINATED && kv.second.waitingTime > maxWait)
-            maxWait = kv.second.waitingTime;
+    for (const PCB &p : processes) {
+        if (p.state == ProcState::TERMINATED && p.getWaitingTime(globalTick) > maxWait)
+            maxWait = p.getWaitingTime(globalTick);
     }
     
     if (maxWait > 0) {
-        for (auto &kv : processes) {
-            const PCB &p = kv.second;
+        for (const PCB &p : processes) {
             if (p.state == ProcState::TERMINATED) {
                 std::cout << "PID " << std::setw(3) << p.id << " │";
-                int bars = (p.waitingTime * 40) / maxWait;
+                int bars = (p.getWaitingTime(globalTick) * 40) / maxWait;
                 for (int i = 0; i < bars; i++) std::cout << "█";
-                std::cout << " " << p.waitingTime << " ticks\n";
+                std::cout << " " << p.getWaitingTime(globalTick) << " ticks\n";
             }
         }
     }
 }
 
-int SchedulerRR::getTick() const { 
+int SchedulerCore::getTick() const { 
     return globalTick; 
 }
 
+const LatencyStats &SchedulerCore::getLatency() const { return latency; }
+
+SchedulerSummary SchedulerCore::getSummary() const {
+    // Promedios con las mismas fórmulas que showStats(); los items cuentan todos los procesos
+    SchedulerSummary s = {globalTick, processes.size(), 0, 0, 0, 0, 0, 0};
+    double cpuTime = 0;
+    for (const PCB &p : processes) {
+        s.itemsProduced += p.itemsProduced;
+        s.itemsConsumed += p.itemsConsumed;
+        if (p.state != ProcState::TERMINATED) continue;
+        s.finished++;
+        s.avgWaiting += p.getWaitingTime(globalTick);
+        s.avgTurnaround += p.turnaround;
+        cpuTime += p.turnaround - p.getWaitingTime(globalTick);
+    }
+    if (s.finished > 0) {
+        s.avgWaiting /= s.finished;
+        s.avgTurnaround /= s.finished;
+    }
+    s.cpuUtilization = globalTick > 0 ? (cpuTime / globalTick) * 100 : 0;
+    return s;
+}
 
-// ========== SCHEDULER SJF - IMPLEMENTACIÓN ==========
-
-SchedulerSJF::SchedulerSJF(MemoryManager &mm) 
-    : globalTick(0), nextPid(1), runningPid(-1), memManager(mm) {}
-
-int SchedulerSJF::createProcess(int burst, int pages) {
-    int pid = nextPid++;
-    PCB pcb(pid, burst, globalTick, pages);
-    pcb.state = ProcState::READY;
-    processes[pid] = pcb;
-    readyQueue.push_back(pid);
-    return pid;
+// ========== SCHEDULER MLFQ - IMPLEMENTACIÓN ==========
+
+SchedulerMLFQ::SchedulerMLFQ(MemoryManager &mm, ProducerConsumer &pc,
+                             const std::vector<int> &levelQuanta, int boostEvery)
+    : SchedulerCore(mm, pc), quanta(levelQuanta), nonEmpty(0),
+      boostPeriod(boostEvery), enqueueSeq(0) {
+    if (quanta.empty()) quanta.push_back(DEFAULT_QUANTUM);
+    if ((int)quanta.size() > MAX_LEVELS) quanta.resize(MAX_LEVELS);
+    for (int &q : quanta) q = std::max(1, q);
+    levels.resize(quanta.size());
+    nextBoost = boostPeriod > 0 ? boostPeriod : INT_MAX;
 }
 
-void SchedulerSJF::tick() {
-    globalTick++;
-    if (runningPid == -1) scheduleNext();
-    for (auto &kv : processes)
-        if (kv.second.state == ProcState::READY)
-            kv.second.waitingTime++;
-
-    if (runningPid != -1) {
-        PCB &p = processes[runningPid];
-        p.state = ProcState::RUNNING;
-        p.burstRemaining--;
-        bool pf = memManager.access(p.id, p.nextPageToAccess);
-        if (pf) p.pageFaults++;
-        p.pageAccesses++;
-        p.nextPageToAccess = (p.nextPageToAccess + 1) % p.numPages;
-
-        if (p.burstRemaining <= 0) {
-            p.state = ProcState::TERMINATED;
-            p.finishTick = globalTick;
-            p.turnaround = p.finishTick - p.arrivalTick;
-            memManager.freeFramesOfPid(p.id);
-            runningPid = -1;
+int SchedulerMLFQ::topLevel() {
+    // Nivel no vacío de mayor prioridad; las entradas obsoletas se descartan
+    // perezosamente (proceso ya no READY o reencolado después)
+    while (nonEmpty) {
+        int lvl = __builtin_ctzll(nonEmpty);
+        std::queue<ReadyEntry> &q = levels[lvl];
+        while (!q.empty()) {
+            const ReadyEntry &e = q.front();
+            const PCB *p = processes.find(e.pid);
+            auto it = latestSeq.find(e.pid);
+            bool current = it != latestSeq.end() && it->second == e.seq;
+            if (current && p && p->state == ProcState::READY) return lvl;
+            if (current) latestSeq.erase(it);
+            q.pop();
         }
+        nonEmpty &= ~(1ULL << lvl);
     }
+    return -1;
+}
+
+void SchedulerMLFQ::enqueueReady(int pid) {
+    int lvl = processes.at(pid).level;
+    latestSeq[pid] = enqueueSeq;
+    levels[lvl].push({pid, enqueueSeq++});
+    nonEmpty |= 1ULL << lvl;
 }
 
-void SchedulerSJF::runTicks(int n) { 
-    for (int i=0;i<n;i++) tick(); 
-}
-
-void SchedulerSJF::scheduleNext() {
-    // eliminar terminados
-    readyQueue.erase(
-        std::remove_if(readyQueue.begin(), readyQueue.end(), [&](int pid){
-            return processes[pid].state == ProcState::TERMINATED;
-        }),
-        readyQueue.end()
-    );
-    if (!readyQueue.empty()) {
-        int best = readyQueue.front();
-        for (int pid : readyQueue)
-            if (processes[pid].burstRemaining < processes[best].burstRemaining)
-                best = pid;
-        readyQueue.erase(std::remove(readyQueue.begin(), readyQueue.end(), best), readyQueue.end());
-        runningPid = best;
+bool SchedulerMLFQ::readyQueueEmpty() const { return nonEmpty == 0; }
+
+int SchedulerMLFQ::timeSlice(const PCB &p) const { return quanta[p.level]; }
+
+void SchedulerMLFQ::scheduleNext() {
+    int lvl = topLevel();
+    if (lvl == -1) return;
+    int pid = levels[lvl].front().pid;
+    levels[lvl].pop();
+    if (levels[lvl].empty()) nonEmpty &= ~(1ULL << lvl);
+    latestSeq.erase(pid);
+    if (processes.at(pid).burstRemaining > 0) {
+        runningPid = pid;
+        quantumUsed = 0;
+    } else terminateProcess(processes.at(pid));
+}
+
+bool SchedulerMLFQ::shouldPreempt(const PCB &running) {
+    int lvl = topLevel();
+    return lvl != -1 && lvl < running.level;
+}
+
+void SchedulerMLFQ::quantumExpired(PCB &p) {
+    // Agotó su porción: pasa al siguiente nivel (menor prioridad)
+    if (p.level < (int)quanta.size() - 1) p.level++;
+}
+
+int SchedulerMLFQ::nextTimer() const { return nextBoost; }
+
+void SchedulerMLFQ::onTimer() {
+    boost();
+    nextBoost = (globalTick / boostPeriod + 1) * boostPeriod;
+}
+
+void SchedulerMLFQ::boost() {
+    // Todos al nivel 0, conservando el orden relativo (nivel, llegada)
+    for (PCB &p : processes) p.level = 0;
+    for (size_t lvl = 1; lvl < levels.size(); lvl++) {
+        while (!levels[lvl].empty()) {
+            levels[0].push(levels[lvl].front());
+            levels[lvl].pop();
+        }
     }
+    if (nonEmpty) nonEmpty = 1;
 }
 
-void SchedulerSJF::listProcesses() const {
-    std::cout << "\n--- Procesos (SJF) ---\n";
-    for (auto &kv : processes) {
-        const PCB &p = kv.second;
-        std::string st;
-        switch (p.state) {
-            case ProcState::NEW: st="NEW"; break;
-            case ProcState::READY: st="READY"; break;
-            case ProcState::RUNNING: st="RUN"; break;
-            case ProcState::WAITING: st="WAIT"; break;
-            case ProcState::TERMINATED: st="TERM"; break;
-            default: st="UNKNOWN"; break;
+// Snapshot: quanta, boost y los PIDs vigentes de cada nivel en orden de
+// cola (las entradas obsoletas se descartarían igual al llegar al frente)
+bool SchedulerMLFQ::savePolicyState(SnapshotWriter &w) const {
+    w.put(SNAPSHOT_POLICY_MLFQ);
+    w.putVector(quanta);
+    w.put(boostPeriod);
+    w.put(nextBoost);
+    for (const auto &level : levels) {
+        std::queue<ReadyEntry> q = level;
+        std::vector<int> pids;
+        for (; !q.empty(); q.pop()) {
+            const ReadyEntry &e = q.front();
+            const PCB *p = processes.find(e.pid);
+            auto it = latestSeq.find(e.pid);
+            if (it != latestSeq.end() && it->second == e.seq && p && p->state == ProcState::READY)
+                pids.push_back(e.pid);
         }
-        std::cout << "PID=" << p.id << " Estado=" << st
-                  << " Burst=" << p.burstRemaining
-                  << " Espera=" << p.waitingTime << "\n";
+        w.putVector(pids);
     }
+    return true;
 }
 
-void SchedulerSJF::showStats() const {
-    double avgWait = 0, avgTurn = 0; 
-    int finished = 0;
-    for (auto &kv : processes) {
-        const PCB &p = kv.second;
-        if (p.state == ProcState::TERMINATED) {
-            finished++;
-            avgWait += p.waitingTime;
-            avgTurn += p.turnaround;
+bool SchedulerMLFQ::loadPolicyState(SnapshotReader &r) {
+    uint32_t tag;
+    std::vector<int> q;
+    int period, next;
+    if (!r.get(tag) || tag != SNAPSHOT_POLICY_MLFQ) return r.fail();
+    if (!r.getVector(q) || !r.get(period) || !r.get(next)) return false;
+    if (q.empty() || (int)q.size() > MAX_LEVELS || *std::min_element(q.begin(), q.end()) < 1 ||
+        (period > 0 ? next < 0 : next != INT_MAX)) return r.fail();
+
+    std::vector<std::queue<ReadyEntry>> nextLevels(q.size());
+    std::unordered_map<int, long long> seqs;
+    long long seq = 0;
+    uint64_t mask = 0;
+    for (size_t lvl = 0; lvl < q.size(); lvl++) {
+        std::vector<int> pids;
+        if (!r.getVector(pids)) return false;
+        for (int pid : pids) {
+            if (seqs.count(pid)) return r.fail();
+            seqs[pid] = seq;
+            nextLevels[lvl].push({pid, seq++});
         }
+        if (!pids.empty()) mask |= 1ULL << lvl;
     }
-    if (finished > 0) { 
-        avgWait/=finished; 
-        avgTurn/=finished; 
+    quanta = std::move(q);
+    boostPeriod = period;
+    nextBoost = next;
+    levels = std::move(nextLevels);
+    latestSeq = std::move(seqs);
+    enqueueSeq = seq;
+    nonEmpty = mask;
+    return true;
+}
+
+int SchedulerMLFQ::getLevels() const { return quanta.size(); }
+
+void SchedulerMLFQ::showQueues() const {
+    std::vector<int> ready(quanta.size(), 0);
+    for (const PCB &p : processes)
+        if (p.state == ProcState::READY) ready[p.level]++;
+    
+    std::cout << "\n=== COLAS MLFQ (tick " << globalTick << ") ===\n";
+    for (size_t lvl = 0; lvl < quanta.size(); lvl++) {
+        std::cout << "Nivel " << lvl << " (quantum " << quanta[lvl] << "): "
+                  << ready[lvl] << " listos";
+        if (runningPid != -1 && processes.at(runningPid).level == (int)lvl)
+            std::cout << "  [en CPU: PID " << runningPid << "]";
+        std::cout << "\n";
     }
-    std::cout << "\n--- Estadísticas SJF ---\n";
-    std::cout << "Tick global: " << globalTick << "\n";
-    std::cout << "Procesos terminados: " << finished << "/" << processes.size() << "\n";
-    std::cout << "Promedio de espera: " << std::fixed << std::setprecision(2) << avgWait << "\n";
-    std::cout << "Promedio de retorno: " << avgTurn << "\n";
-    memManager.showFrames();
+    if (boostPeriod > 0) std::cout << "Próximo boost: tick " << nextBoost << "\n";
 }
 
-int SchedulerSJF::getTick() const {
-    return globalTick;
+void SchedulerMLFQ::showStats() const {
+    SchedulerCore::showStats();
+    showQueues();
 }
@@ -2,92 +2,233 @@
 #define SCHEDULER_H
 
 #include <queue>
-#include <map>
 #include <vector>
+#include <functional>
+#include <unordered_map>
+#include <cstdint>
 #include <iostream>
 #include "Process.h"
+#include "ProcessTable.h"
 #include "../mem/MemoryManager.h"
 #include "Synchronization.h"
+#include "TimingWheel.h"
+#include "LatencyHistogram.h"
 
-// ========== SCHEDULER ROUND ROBIN ==========
+class TimelineRecorder;
+
+// Etiquetas de política en el snapshot (savePolicyState/loadPolicyState)
+const uint32_t SNAPSHOT_POLICY_RR = 1;
+const uint32_t SNAPSHOT_POLICY_SJF = 2;
+const uint32_t SNAPSHOT_POLICY_PRIORITY = 3;
+const uint32_t SNAPSHOT_POLICY_MLFQ = 4;
+const uint32_t SNAPSHOT_POLICY_CFS = 5;
+const uint32_t SNAPSHOT_POLICY_RT = 6;
+const uint32_t SNAPSHOT_POLICY_SMP = 7;
+
+// ========== RESUMEN DE MÉTRICAS ==========
+struct SchedulerSummary {
+    int tick;
+    int created;
+    int finished;
+    double avgWaiting;
+    double avgTurnaround;
+    double cpuUtilization;      // % del tiempo con un proceso terminado en CPU
+    int itemsProduced;
+    int itemsConsumed;
+};
+
+// ========== NÚCLEO COMÚN DE PLANIFICACIÓN ==========
 /**
- * Planificador Round-Robin con soporte para:
+ * Mecánica compartida por los planificadores de un CPU:
  * - Hilos (multithreading)
- * - Sincronización con ProductorConsumidor
+ * - Sincronización con ProductorConsumidor (bloqueo real: los procesos/hilos
+ *   bloqueados se despiertan sólo cuando su semáforo recibe signal)
  * - Gestión de memoria virtual
+ * - Motor dirigido por eventos: runTicks() salta al próximo evento
+ *   (fin de quantum / fin de ráfaga) sin recorrer la tabla cada tick
+ * - Llegadas programadas, sleep y timeouts de semáforos en una rueda de
+ *   temporizadores jerárquica
+ * - Modelos de referencias a memoria por proceso (AccessModel.h)
+ * - Reportes y estadísticas
+ *
+ * Cada política define su cola de listos, el tamaño de la porción de CPU
+ * y si un proceso listo expropia al que está en ejecución.
  */
-class SchedulerRR {
-private:
-    int quantum;
+class SchedulerCore {
+protected:
     int globalTick;
-    int nextPid;
-    std::map<int, PCB> processes;
-    std::queue<int> readyQueue;
+    ProcessTable processes;
     int runningPid;
     int quantumUsed;
     MemoryManager &memManager;
     ProducerConsumer &prodCons;
     
+    // Motor dirigido por eventos
+    bool eventDriven;
+    
+    // Waiters estacionados en semáforos: waiterId -> (pid, tid); tid=0 = el PCB
+    std::vector<std::pair<int, int>> waiterRefs;
+    std::vector<int> freeWaiterIds;
+    std::vector<int> waiterTimers;      // waiterId -> handle del timeout (-1 = ninguno)
+    
+    // Llegadas, sleep y timeouts (la rueda guarda PIDs; el PCB, su handle)
+    TimingWheel timers;
+    int waitTimeout;                    // Ticks máximos en un semáforo (0 = sin límite)
+    
+    // Referencias a memoria: modelo de los procesos nuevos y parámetros comunes
+    AccessModel accessModel;
+    AccessParams accessParams;
+    uint64_t accessSeed;
+    
+    int threadLimit;                    // Máximo de hilos por proceso
+    LatencyStats latency;               // Percentiles de los procesos terminados
+    TimelineRecorder *timeline;         // Línea de tiempo opcional (nullptr = desactivada)
+    
+    // Política de planificación
+    virtual void enqueueReady(int pid) = 0;
+    virtual void scheduleNext() = 0;
+    virtual bool readyQueueEmpty() const = 0;
+    virtual int timeSlice(const PCB &p) const = 0;
+    virtual bool shouldPreempt(const PCB &running);
+    virtual void readyWorkChanged(int pid);
+    virtual void quantumExpired(PCB &p);
+    virtual void threadReady(PCB &p, int tid);  // Hilo listo en un proceso que no está WAITING
+    virtual void dequeueReady(int pid);         // Un proceso READY sale de la cola (kill/suspend)
+    virtual void accountRuntime(PCB &p, int ticks);
+    virtual bool jobCompleted(PCB &p);          // true = el proceso sigue vivo (tarea periódica)
+    virtual int nextTimer() const;      // Próximo tick con trabajo periódico de la política
+    virtual void onTimer();
+    // Estado propio de la política en el snapshot (false = no soportado)
+    virtual bool savePolicyState(SnapshotWriter &w) const;
+    virtual bool loadPolicyState(SnapshotReader &r);
+    
     void executeThreadTick(PCB &p);
     void unblockWaitingProcesses();
-    void scheduleNext();
+    void checkPreemption();
+    void fireTimer();
+    int syncOperation(PCB &p, int tid, int &waiterId);
+    void cancelWaits(PCB &p);
+    void clearWaitTimeout(int waiterId);
+    bool hasRunnableThread(const PCB &p) const;
+    void runSlice(PCB &p, int ticks);
+    void finishBurst(PCB &p);
+    virtual void terminateProcess(PCB &p);  // TERMINATED, retorno, latencias y marcos
+    
+    // Motor genérico (SchedulerEngine.h): Self es el tipo concreto del
+    // planificador, así las políticas final se inlinean en el bucle de ticks
+    template <class Self> void fireTimerImpl(Self &self);
+    template <class Self> void expireTimersImpl(Self &self);
+    template <class Self> void waitTimedOutImpl(Self &self, int waiterId);
+    template <class Self> int nextWakeupImpl(Self &self) const;
+    template <class Self> void checkPreemptionImpl(Self &self);
+    template <class Self> void unblockWaitingProcessesImpl(Self &self);
+    template <class Self> void runSliceImpl(Self &self, PCB &p, int ticks);
+    template <class Self> void finishBurstImpl(Self &self, PCB &p);
+    template <class Self> void tickImpl(Self &self);
+    template <class Self> void runTicksImpl(Self &self, int n);
 
 public:
-    SchedulerRR(MemoryManager &mm, ProducerConsumer &pc, int q=DEFAULT_QUANTUM);
+    SchedulerCore(MemoryManager &mm, ProducerConsumer &pc);
+    virtual ~SchedulerCore() {}
     
     // Gestión de procesos
     int createProcess(int burst, int pages = 4, ProcType type = ProcType::NORMAL);
+    // Proceso NEW que pasa a READY al llegar el reloj a arrivalTick
+    int scheduleProcess(int arrivalTick, int burst, int pages = 4, ProcType type = ProcType::NORMAL);
     int createThreadInProcess(int pid, int burstPerThread);
+    // Tarea periódica (EDF/RM); -1 si la política no las admite
+    virtual int createPeriodicTask(int wcet, int period, int deadline = 0, int pages = 4);
+    void setThreadLimit(int limit);
+    int getThreadLimit() const;
     bool killProcess(int pid);
     bool suspendProcess(int pid);
     bool resumeProcess(int pid);
+    virtual bool setPriority(int pid, int nice);  // Prioridad estática (PCB::nice)
+    bool sleepProcess(int pid, int ticks);  // WAITING hasta globalTick + ticks
+    void setWaitTimeout(int ticks);         // Vencido, el waiter vuelve sin su ítem
+    int getWaitTimeout() const;
+    int pendingTimers() const;
+    // Modelo para los procesos que se creen después; los parámetros rigen
+    // para todos. Cada PCB siembra su flujo con (seed, PID).
+    void setAccessModel(AccessModel model, const AccessParams &params, uint64_t seed = 1);
+    bool setProcessAccessModel(int pid, AccessModel model);
+    AccessModel getAccessModel() const;
+    const AccessParams &getAccessParams() const;
+    uint64_t getAccessSeed() const;
+    int reapTerminated();
     
     // Ejecución
-    void tick();
-    void runTicks(int n);
+    virtual void tick();
+    virtual void runTicks(int n);
+    void setEventDriven(bool enabled);
+    bool isEventDriven() const;
+    void setTimeline(TimelineRecorder *recorder);   // nullptr la desactiva
+    
+    // Snapshot: tabla de procesos, reloj, waiters y cola de la política.
+    // La memoria y el buffer se guardan aparte (Snapshot.h).
+    bool saveState(SnapshotWriter &w) const;
+    bool loadState(SnapshotReader &r);
     
     // Visualización
     void listProcesses() const;
     void showThreads(int pid) const;
-    void showStats() const;
+    virtual void showStats() const;
     void showDetailedReport() const;
     
     // Getters
     int getTick() const;
+    SchedulerSummary getSummary() const;
+    const LatencyStats &getLatency() const;
 };
 
-// ========== SCHEDULER SJF (Shortest Job First) ==========
+// ========== SCHEDULER MLFQ (Multi-Level Feedback Queue) ==========
 /**
- * Planificador SJF (non-preemptive)
- * Selecciona el proceso con menor burst time restante.
+ * Planificador de colas multinivel con retroalimentación.
+ * - Un nivel por quantum configurado; el nivel 0 es el de mayor prioridad.
+ * - Un proceso que agota su quantum baja un nivel; si se bloquea o es
+ *   expropiado conserva su nivel.
+ * - Un proceso listo en un nivel más alto expropia al que está en CPU.
+ * - Cada boostPeriod ticks todos los procesos vuelven al nivel 0.
+ * - Selección de nivel O(1): bitmap de colas no vacías.
  */
-class SchedulerSJF {
+class SchedulerMLFQ : public SchedulerCore {
+public:
+    static const int MAX_LEVELS = 64;   // Un bit del bitmap por nivel
+
 private:
-    int globalTick;
-    int nextPid;
-    std::map<int, PCB> processes;
-    std::vector<int> readyQueue;
-    int runningPid;
-    MemoryManager &memManager;
+    struct ReadyEntry {
+        int pid;
+        long long seq;
+    };
     
-    void scheduleNext();
+    std::vector<int> quanta;
+    std::vector<std::queue<ReadyEntry>> levels;
+    uint64_t nonEmpty;                  // Bit i activo = levels[i] tiene entradas
+    int boostPeriod;
+    int nextBoost;
+    long long enqueueSeq;
+    std::unordered_map<int, long long> latestSeq;  // pid -> seq de su entrada vigente
+    
+    int topLevel();
+    void boost();
+    void enqueueReady(int pid) override;
+    void scheduleNext() override;
+    bool readyQueueEmpty() const override;
+    int timeSlice(const PCB &p) const override;
+    bool shouldPreempt(const PCB &running) override;
+    void quantumExpired(PCB &p) override;
+    int nextTimer() const override;
+    void onTimer() override;
+    bool savePolicyState(SnapshotWriter &w) const override;
+    bool loadPolicyState(SnapshotReader &r) override;
 
 public:
-    SchedulerSJF(MemoryManager &mm);
-    
-    // Gestión de procesos
-    int createProcess(int burst, int pages = 4);
+    SchedulerMLFQ(MemoryManager &mm, ProducerConsumer &pc,
+                  const std::vector<int> &levelQuanta = {2, 4, 8}, int boostEvery = 100);
     
-    // Ejecución
-    void tick();
-    void runTicks(int n);
-    
-    // Visualización
-    void listProcesses() const;
-    void showStats() const;
-    
-    // Getters
-    int getTick() const;
+    int getLevels() const;
+    void showQueues() const;
+    void showStats() const override;
 };
 
 #endif // SCHEDULER_H
@@ -0,0 +1,230 @@
+#include "SchedulerCFS.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+// ========== SCHEDULER CFS - IMPLEMENTACIÓN ==========
+
+SchedulerCFS::SchedulerCFS(MemoryManager &mm, ProducerConsumer &pc, int targetLat, int minGran)
+    : SchedulerCore(mm, pc), targetLatency(std::max(1, targetLat)),
+      minGranularity(std::max(1, minGran)), minVruntime(0), treeWeight(0),
+      preemptPending(false) {
+    wakeupGranularity = vruntimePerTick(NICE_0_WEIGHT);
+}
+
+int SchedulerCFS::niceToWeight(int nice) {
+    // Tabla de Linux (sched_prio_to_weight): cada nivel de nice ~10% de CPU
+    static const int weights[40] = {
+        /* -20 */ 88761, 71755, 56483, 46273, 36291,
+        /* -15 */ 29154, 23254, 18705, 14949, 11916,
+        /* -10 */  9548,  7620,  6100,  4904,  3906,
+        /*  -5 */  3121,  2501,  1991,  1586,  1277,
+        /*   0 */  1024,   820,   655,   526,   423,
+        /*   5 */   335,   272,   215,   172,   137,
+        /*  10 */   110,    87,    70,    56,    45,
+        /*  15 */    36,    29,    23,    18,    15,
+    };
+    nice = std::min(std::max(nice, -20), 19);
+    return weights[nice + 20];
+}
+
+long long SchedulerCFS::vruntimePerTick(int weight) {
+    return (long long)NICE_0_WEIGHT * 1024 / weight;
+}
+
+void SchedulerCFS::updateMinVruntime() {
+    long long v = LLONG_MAX;
+    if (runningPid != -1 && processes.at(runningPid).state == ProcState::RUNNING)
+        v = processes.at(runningPid).vruntime;
+    if (!tree.empty()) v = std::min(v, tree.begin()->first);
+    if (v != LLONG_MAX) minVruntime = std::max(minVruntime, v);
+}
+
+void SchedulerCFS::enqueueReady(int pid) {
+    PCB &p = processes.at(pid);
+
+    // El proceso que deja la CPU (quantum/expropiación) conserva su vruntime
+    if (pid != runningPid) {
+        long long floor = p.cpuTime == 0
+            ? minVruntime
+            : minVruntime - targetLatency * vruntimePerTick(NICE_0_WEIGHT) / 2;
+        p.vruntime = std::max(p.vruntime, floor);
+
+        if (runningPid != -1) {
+            const PCB &cur = processes.at(runningPid);
+            if (cur.state == ProcState::RUNNING && p.vruntime + wakeupGranularity < cur.vruntime)
+                preemptPending = true;
+        }
+    }
+
+    if (tree.insert({p.vruntime, pid}).second) treeWeight += p.weight;
+}
+
+void SchedulerCFS::dequeueReady(int pid) {
+    PCB &p = processes.at(pid);
+    if (tree.erase({p.vruntime, pid})) treeWeight -= p.weight;
+}
+
+bool SchedulerCFS::readyQueueEmpty() const { return tree.empty(); }
+
+void SchedulerCFS::scheduleNext() {
+    preemptPending = false;
+    if (tree.empty()) return;
+
+    int pid = tree.begin()->second;
+    tree.erase(tree.begin());
+    PCB &p = processes.at(pid);
+    treeWeight -= p.weight;
+
+    if (p.burstRemaining > 0) {
+        runningPid = pid;
+        quantumUsed = 0;
+    } else terminateProcess(p);
+}
+
+int SchedulerCFS::timeSlice(const PCB &p) const {
+    // Porción proporcional al peso dentro de la latencia objetivo
+    long long total = treeWeight + p.weight;
+    int slice = targetLatency * (long long)p.weight / total;
+    return std::max(minGranularity, slice);
+}
+
+bool SchedulerCFS::shouldPreempt(const PCB &) {
+    // Sólo al despertar/llegar un proceso: el resto lo decide timeSlice()
+    if (!preemptPending) return false;
+    preemptPending = false;
+    return !tree.empty();
+}
+
+void SchedulerCFS::accountRuntime(PCB &p, int ticks) {
+    p.vruntime += ticks * vruntimePerTick(p.weight);
+    updateMinVruntime();
+}
+
+bool SchedulerCFS::setPriority(int pid, int nice) {
+    PCB *p = processes.find(pid);
+    if (!p || p->state == ProcState::TERMINATED) return false;
+    nice = std::min(std::max(nice, -20), 19);
+    int weight = niceToWeight(nice);
+    if (p->state == ProcState::READY && tree.count({p->vruntime, pid}))
+        treeWeight += weight - p->weight;
+    p->nice = nice;
+    p->weight = weight;
+    return true;
+}
+
+// ========== SNAPSHOT ==========
+// El árbol como (vruntime, pid) en orden; el peso total se guarda tal cual
+// porque los PCB se cargan después de la política
+
+bool SchedulerCFS::savePolicyState(SnapshotWriter &w) const {
+    w.put(SNAPSHOT_POLICY_CFS);
+    w.put(targetLatency);
+    w.put(minGranularity);
+    w.put(minVruntime);
+    w.put(treeWeight);
+    w.put(preemptPending);
+    std::vector<long long> keys;
+    std::vector<int> pids;
+    for (const auto &e : tree) {
+        keys.push_back(e.first);
+        pids.push_back(e.second);
+    }
+    w.putVector(keys);
+    w.putVector(pids);
+    return true;
+}
+
+bool SchedulerCFS::loadPolicyState(SnapshotReader &r) {
+    uint32_t tag;
+    int targetLat, minGran;
+    long long minV, weight;
+    bool pending;
+    std::vector<long long> keys;
+    std::vector<int> pids;
+    if (!r.get(tag) || tag != SNAPSHOT_POLICY_CFS) return r.fail();
+    if (!r.get(targetLat) || !r.get(minGran) || !r.get(minV) || !r.get(weight) || !r.get(pending) ||
+        !r.getVector(keys) || !r.getVector(pids)) return false;
+    if (targetLat < 1 || minGran < 1 || weight < 0 || keys.size() != pids.size()) return r.fail();
+    // Un PID aparece a lo sumo una vez en el árbol
+    std::vector<int> unique = pids;
+    std::sort(unique.begin(), unique.end());
+    if (std::adjacent_find(unique.begin(), unique.end()) != unique.end()) return r.fail();
+    std::set<std::pair<long long, int>> nextTree;
+    for (size_t i = 0; i < keys.size(); i++) nextTree.insert({keys[i], pids[i]});
+    targetLatency = targetLat;
+    minGranularity = minGran;
+    minVruntime = minV;
+    treeWeight = weight;
+    preemptPending = pending;
+    tree = std::move(nextTree);
+    return true;
+}
+
+// ========== MÉTRICAS DE EQUIDAD ==========
+// Cuota normalizada: ticks en CPU / (peso relativo * ticks ejecutable).
+// Con reparto perfecto todos los procesos que compiten juntos tienen la misma.
+
+static double normalizedShare(const PCB &p, int now) {
+    int runnable = p.cpuTime + p.getReadyTime(now);
+    if (runnable == 0) return -1;
+    return p.cpuTime / ((double)p.weight / SchedulerCFS::NICE_0_WEIGHT * runnable);
+}
+
+double SchedulerCFS::getJainIndex() const {
+    double sum = 0, sumSq = 0;
+    int n = 0;
+    for (const PCB &p : processes) {
+        double x = normalizedShare(p, globalTick);
+        if (x < 0) continue;
+        sum += x;
+        sumSq += x * x;
+        n++;
+    }
+    return (n > 0 && sumSq > 0) ? (sum * sum) / (n * sumSq) : 1.0;
+}
+
+void SchedulerCFS::showFairness() const {
+    double sum = 0;
+    int n = 0;
+    for (const PCB &p : processes) {
+        double x = normalizedShare(p, globalTick);
+        if (x < 0) continue;
+        sum += x;
+        n++;
+    }
+    double mean = n > 0 ? sum / n : 0;
+
+    std::cout << "\n┌─────────────────────────────────────────────────────────────────────────────┐\n";
+    std::cout << "│                    EQUIDAD CFS - CUOTA DE CPU POR PROCESO                   │\n";
+    std::cout << "├─────┬──────┬───────┬────────────┬───────┬────────┬────────────┬────────────┤\n";
+    std::cout << "│ PID │ Nice │ Peso  │  vruntime  │  CPU  │ Listo  │ Cuota norm │  Desv. %   │\n";
+    std::cout << "├─────┼──────┼───────┼────────────┼───────┼────────┼────────────┼────────────┤\n";
+
+    for (const PCB &p : processes) {
+        double x = normalizedShare(p, globalTick);
+        std::cout << "│ " << std::setw(3) << p.id
+                  << " │ " << std::setw(4) << p.nice
+                  << " │ " << std::setw(5) << p.weight
+                  << " │ " << std::setw(10) << p.vruntime
+                  << " │ " << std::setw(5) << p.cpuTime
+                  << " │ " << std::setw(6) << p.getReadyTime(globalTick) << " │ ";
+        if (x < 0) {
+            std::cout << std::setw(10) << "-" << " │ " << std::setw(10) << "-" << " │\n";
+        } else {
+            double dev = mean > 0 ? (x - mean) / mean * 100 : 0;
+            std::cout << std::setw(10) << std::fixed << std::setprecision(3) << x
+                      << " │ " << std::setw(10) << std::setprecision(1) << dev << " │\n";
+        }
+    }
+    std::cout << "└─────┴──────┴───────┴────────────┴───────┴────────┴────────────┴────────────┘\n";
+    std::cout << "Índice de Jain: " << std::fixed << std::setprecision(4) << getJainIndex()
+              << " (1 = reparto perfecto) | min_vruntime: " << minVruntime << "\n";
+}
+
+void SchedulerCFS::showStats() const {
+    SchedulerCore::showStats();
+    showFairness();
+}
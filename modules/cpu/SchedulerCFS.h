@@ -0,0 +1,61 @@
+#ifndef SCHEDULER_CFS_H
+#define SCHEDULER_CFS_H
+
+#include <set>
+#include <utility>
+#include "Scheduler.h"
+
+// ========== SCHEDULER CFS (Completely Fair Scheduler) ==========
+/**
+ * Planificador justo al estilo de Linux CFS.
+ * - Cada PCB acumula vruntime: tiempo en CPU ponderado por su peso
+ *   (nice 0 = 1024; menor nice = más peso = vruntime crece más lento).
+ * - Los procesos listos viven en un árbol ordenado (std::set, rojo-negro)
+ *   por (vruntime, pid): el siguiente es el de menor vruntime, O(log n).
+ * - Porción dinámica: targetLatency * peso / peso total ejecutable,
+ *   nunca menor que minGranularity.
+ * - Un proceso nuevo arranca en min_vruntime; uno que despierta recibe
+ *   como mucho media latencia de crédito y expropia si su vruntime queda
+ *   por debajo del actual en más de wakeupGranularity.
+ */
+class SchedulerCFS : public SchedulerCore {
+public:
+    static const int NICE_0_WEIGHT = 1024;
+
+private:
+    int targetLatency;
+    int minGranularity;
+    long long wakeupGranularity;        // En unidades de vruntime
+    long long minVruntime;              // Monótono; referencia para nuevos/despertados
+    long long treeWeight;               // Suma de pesos en el árbol
+    bool preemptPending;
+    std::set<std::pair<long long, int>> tree;   // (vruntime, pid)
+
+    static long long vruntimePerTick(int weight);
+    void updateMinVruntime();
+
+    void enqueueReady(int pid) override;
+    void dequeueReady(int pid) override;
+    void scheduleNext() override;
+    bool readyQueueEmpty() const override;
+    int timeSlice(const PCB &p) const override;
+    bool shouldPreempt(const PCB &running) override;
+    void accountRuntime(PCB &p, int ticks) override;
+    bool savePolicyState(SnapshotWriter &w) const override;
+    bool loadPolicyState(SnapshotReader &r) override;
+
+public:
+    SchedulerCFS(MemoryManager &mm, ProducerConsumer &pc,
+                 int targetLat = 12, int minGran = 2);
+
+    static int niceToWeight(int nice);
+    // Además de PCB::nice recalcula el peso (y el total del árbol si está READY)
+    bool setPriority(int pid, int nice) override;
+
+    // Estadísticas (incluye métricas de equidad)
+    void showStats() const override;
+    void showFairness() const;
+    double getJainIndex() const;
+};
+
+#endif // SCHEDULER_CFS_H
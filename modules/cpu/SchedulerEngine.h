@@ -0,0 +1,327 @@
+#ifndef SCHEDULER_ENGINE_H
+#define SCHEDULER_ENGINE_H
+
+#include <algorithm>
+#include <climits>
+#include "Scheduler.h"
+#include "../timeline/Timeline.h"
+
+// ========== MOTOR DE PLANIFICACIÓN (PLANTILLAS) ==========
+// Bucle de tick y motor de eventos de SchedulerCore, parametrizados por el
+// tipo concreto del planificador. Con Self = SchedulerCore los hooks de la
+// política se llaman por vtable; con Self = Scheduler<Policy> son final y
+// el compilador los resuelve e inlinea.
+
+template <class Self>
+void SchedulerCore::fireTimerImpl(Self &self) {
+    // Sin temporizadores vencidos el costo es una comparación
+    if (globalTick >= timers.nextExpiry()) expireTimersImpl(self);
+    if (globalTick >= self.nextTimer()) self.onTimer();
+}
+
+template <class Self>
+int SchedulerCore::nextWakeupImpl(Self &self) const {
+    return std::min(self.nextTimer(), timers.nextExpiry());
+}
+
+template <class Self>
+void SchedulerCore::expireTimersImpl(Self &self) {
+    timers.advance(globalTick, [&](const TimerEntry &e) {
+        if (e.kind == TimerKind::TIMEOUT) {
+            waitTimedOutImpl(self, e.arg);
+            return;
+        }
+        PCB *pp = processes.find(e.pid);
+        if (!pp) return;
+        PCB &p = *pp;
+        p.timerId = -1;
+        if (e.kind == TimerKind::ARRIVAL) {
+            p.setState(ProcState::READY, globalTick);
+            self.enqueueReady(p.id);
+            if (timeline) timeline->processCreated(globalTick, p.id, p.type);
+        } else if (p.state == ProcState::WAITING) {
+            // Suspendido mientras dormía: resumeProcess lo pasa a READY
+            p.setState(ProcState::READY, globalTick);
+            self.enqueueReady(p.id);
+            if (timeline) timeline->wake(globalTick, p.id, 0);
+        }
+    });
+}
+
+template <class Self>
+void SchedulerCore::waitTimedOutImpl(Self &self, int waiterId) {
+    // La operación se abandona: el waiter sale del semáforo sin su ítem
+    std::pair<int, int> ref = waiterRefs[waiterId];
+    waiterTimers[waiterId] = -1;
+    prodCons.cancel(waiterId);
+    freeWaiterIds.push_back(waiterId);
+
+    PCB *pp = processes.find(ref.first);
+    if (!pp) return;
+    PCB &p = *pp;
+    if (ref.second == 0) {
+        p.waiterId = -1;
+        p.blockedOnSemaphore = -1;
+    } else {
+        Thread &t = p.thread(ref.second);
+        t.waiterId = -1;
+        t.blockedOnSemaphore = -1;
+        p.setThreadState(t, ThreadState::THREAD_READY);
+    }
+    if (timeline) timeline->wake(globalTick, p.id, ref.second);
+
+    if (p.state == ProcState::WAITING && p.timerId == -1) {
+        p.setState(ProcState::READY, globalTick);
+        self.enqueueReady(p.id);
+    } else if (ref.second != 0 &&
+               (p.state == ProcState::READY || p.state == ProcState::RUNNING)) {
+        self.threadReady(p, ref.second);
+    }
+}
+
+template <class Self>
+void SchedulerCore::checkPreemptionImpl(Self &self) {
+    if (runningPid == -1) return;
+    PCB &p = processes.at(runningPid);
+    if (p.state == ProcState::RUNNING && self.shouldPreempt(p)) {
+        if (timeline) timeline->preempt(globalTick, p.id, false);
+        p.setState(ProcState::READY, globalTick);
+        self.enqueueReady(p.id);
+        runningPid = -1;
+        quantumUsed = 0;
+    }
+}
+
+template <class Self>
+void SchedulerCore::unblockWaitingProcessesImpl(Self &self) {
+    // Despertar sólo a los waiters cuyo semáforo recibió signal:
+    // su operación de productor/consumidor ya fue completada por el buffer
+    int waiterId;
+    while (prodCons.popWakeup(waiterId)) {
+        std::pair<int, int> ref = waiterRefs[waiterId];
+        freeWaiterIds.push_back(waiterId);
+        clearWaitTimeout(waiterId);
+
+        PCB *pp = processes.find(ref.first);
+        if (!pp) continue;
+        PCB &p = *pp;
+
+        if (ref.second == 0) {
+            p.waiterId = -1;
+            p.blockedOnSemaphore = -1;
+            if (p.type == ProcType::PRODUCER) p.itemsProduced++;
+            else p.itemsConsumed++;
+        } else {
+            Thread &t = p.thread(ref.second);
+            t.waiterId = -1;
+            t.blockedOnSemaphore = -1;
+            p.setThreadState(t, ThreadState::THREAD_READY);
+            if (p.type == ProcType::PRODUCER) { t.itemsProduced++; p.itemsProduced++; }
+            else { t.itemsConsumed++; p.itemsConsumed++; }
+        }
+        if (timeline) {
+            // La operación pendiente se completó al despertar
+            timeline->wake(globalTick, p.id, ref.second);
+            timeline->item(globalTick, p.id, ref.second, p.type == ProcType::PRODUCER);
+        }
+
+        // Un proceso suspendido sigue suspendido hasta resumeProcess;
+        // uno dormido espera su temporizador
+        if (p.state == ProcState::WAITING && p.timerId == -1) {
+            p.setState(ProcState::READY, globalTick);
+            self.enqueueReady(p.id);
+        } else if (ref.second != 0 &&
+                   (p.state == ProcState::READY || p.state == ProcState::RUNNING)) {
+            self.threadReady(p, ref.second);
+        }
+    }
+}
+
+template <class Self>
+void SchedulerCore::runSliceImpl(Self &self, PCB &p, int ticks) {
+    // Ejecuta 'ticks' ticks consecutivos de un proceso NORMAL sin hilos
+    p.setState(ProcState::RUNNING, globalTick);
+    p.cpuTime += ticks;
+    self.accountRuntime(p, ticks);
+    if (timeline) timeline->runSlice(globalTick, ticks, p.id, 0);
+    for (int i = 0; i < ticks; i++) {
+        bool pf = memManager.access(p.id, p.nextPageToAccess,
+                                    accessIsWrite(p.id, p.nextPageToAccess, accessParams));
+        if (pf) {
+            p.pageFaults++;
+            if (timeline) timeline->pageFault(globalTick - 1 + i, p.id, 0, p.nextPageToAccess);
+        }
+        p.pageAccesses++;
+        p.nextPageToAccess = p.access.next(p.nextPageToAccess, p.numPages, accessParams);
+    }
+    p.burstRemaining -= ticks;
+}
+
+template <class Self>
+void SchedulerCore::finishBurstImpl(Self &self, PCB &p) {
+    // Un trabajo periódico completado espera su próxima activación
+    if (self.jobCompleted(p)) {
+        p.setState(ProcState::WAITING, globalTick);
+        return;
+    }
+    terminateProcess(p);
+}
+
+template <class Self>
+void SchedulerCore::tickImpl(Self &self) {
+    // El despacho ocurre al inicio del tick: un proceso descartado por
+    // scheduleNext ya no cuenta espera en este tick.
+    fireTimerImpl(self);
+    checkPreemptionImpl(self);
+    if (runningPid == -1) self.scheduleNext();
+    globalTick++;
+
+    if (runningPid != -1) {
+        PCB &p = processes.at(runningPid);
+        p.setState(ProcState::RUNNING, globalTick);
+        p.cpuTime++;
+        self.accountRuntime(p, 1);
+        quantumUsed++;
+        // Los hilos registran su tramo en executeThreadTick
+        if (timeline && !p.hasThreads) timeline->running(globalTick, p.id, 0);
+        
+        // Acceso a memoria (del proceso: el fallo va a la pista del PCB)
+        bool pf = memManager.access(p.id, p.nextPageToAccess,
+                                    accessIsWrite(p.id, p.nextPageToAccess, accessParams));
+        if (pf) {
+            p.pageFaults++;
+            if (timeline) timeline->pageFault(globalTick - 1, p.id, 0, p.nextPageToAccess);
+        }
+        p.pageAccesses++;
+        p.nextPageToAccess = p.access.next(p.nextPageToAccess, p.numPages, accessParams);
+
+        // Si el proceso tiene hilos, ejecutar lógica de threads
+        if (p.hasThreads) {
+            executeThreadTick(p);
+            
+            // Verificar si todos los threads terminaron
+            if (p.burstRemaining <= 0) {
+                finishBurstImpl(self, p);
+                runningPid = -1;
+                quantumUsed = 0;
+            } else if (p.state == ProcState::WAITING) {
+                // Todos sus hilos vivos quedaron bloqueados
+                runningPid = -1;
+                quantumUsed = 0;
+            } else if (quantumUsed >= self.timeSlice(p)) {
+                if (timeline) timeline->preempt(globalTick, p.id, true);
+                self.quantumExpired(p);
+                p.setState(ProcState::READY, globalTick);
+                self.enqueueReady(p.id);
+                runningPid = -1;
+                quantumUsed = 0;
+            }
+        } else {
+            // Lógica sin threads (proceso normal)
+            p.burstRemaining--;
+            
+            // Lógica de productor-consumidor
+            if (p.type == ProcType::PRODUCER || p.type == ProcType::CONSUMER) {
+                int waiterId;
+                int result = syncOperation(p, 0, waiterId);
+                if (result == 0) {
+                    if (p.type == ProcType::PRODUCER) p.itemsProduced++;
+                    else p.itemsConsumed++;
+                    if (timeline) timeline->item(globalTick, p.id, 0, p.type == ProcType::PRODUCER);
+                } else {
+                    // Queda estacionado en la cola del semáforo hasta su signal
+                    p.setState(ProcState::WAITING, globalTick);
+                    p.blockedOnSemaphore = result - 1;
+                    p.waiterId = waiterId;
+                    if (timeline) timeline->block(globalTick, p.id, 0, result - 1);
+                    runningPid = -1;
+                    quantumUsed = 0;
+                    return;
+                }
+            }
+
+            if (p.burstRemaining <= 0) {
+                finishBurstImpl(self, p);
+                runningPid = -1;
+                quantumUsed = 0;
+            } else if (quantumUsed >= self.timeSlice(p)) {
+                if (timeline) timeline->preempt(globalTick, p.id, true);
+                self.quantumExpired(p);
+                p.setState(ProcState::READY, globalTick);
+                self.enqueueReady(p.id);
+                runningPid = -1;
+                quantumUsed = 0;
+            }
+        }
+    }
+    
+    // DESBLOQUEO: mover a READY los procesos/threads despertados por signal
+    unblockWaitingProcessesImpl(self);
+}
+
+template <class Self>
+void SchedulerCore::runTicksImpl(Self &self, int n) {
+    if (!eventDriven) {
+        for (int i=0;i<n;i++) tickImpl(self); 
+        return;
+    }
+
+    int target = globalTick + n;
+    while (globalTick < target) {
+        fireTimerImpl(self);
+        checkPreemptionImpl(self);
+        if (runningPid == -1) {
+            self.scheduleNext();
+            if (runningPid == -1) {
+                // CPU ociosa: nadie puede hacer signal, así que ningún
+                // bloqueado despertará. Saltar directo al final.
+                // Si scheduleNext descartó un proceso, ese tick se consume sin ejecutar.
+                // Un temporizador de la política (p. ej. boost MLFQ) o de la rueda
+                // (llegadas, sleep, timeouts) también corta el salto.
+                globalTick += self.readyQueueEmpty() ? std::min(target, nextWakeupImpl(self)) - globalTick : 1;
+                continue;
+            }
+        }
+
+        PCB &p = processes.at(runningPid);
+        if (p.hasThreads || p.type != ProcType::NORMAL ||
+            p.state == ProcState::TERMINATED || p.burstRemaining <= 0) {
+            // Casos que requieren la semántica completa de tick()
+            // (productor/consumidor puede hacer signal y despertar a otros)
+            // (scheduleNext no depende del reloj, así que puede ir antes)
+            tickImpl(self);
+            continue;
+        }
+
+        // Próximo evento del proceso en CPU: fin de ráfaga o fin de quantum.
+        // Llegadas, sleep, timeouts y temporizadores de la política salen de
+        // nextWakeupImpl(), así que basta con un único evento propio
+        int untilQuantum = std::max(1, self.timeSlice(p) - quantumUsed);
+        bool completes = p.burstRemaining <= untilQuantum;
+        int eventTick = globalTick + (completes ? p.burstRemaining : untilQuantum);
+        int end = std::min(std::min(eventTick, target), nextWakeupImpl(self));
+        int slice = end - globalTick;
+
+        // La transición a RUNNING ocurre dentro del primer tick del tramo;
+        // la espera del resto de procesos se deriva al consultarla.
+        globalTick++;
+        runSliceImpl(self, p, slice);
+        globalTick = end;
+        quantumUsed += slice;
+
+        // Corte por fin de runTicks o por temporizador: el evento se recalcula luego
+        if (end < eventTick) continue;
+        if (completes) {
+            finishBurstImpl(self, p);
+        } else {
+            if (timeline) timeline->preempt(globalTick, p.id, true);
+            self.quantumExpired(p);
+            p.setState(ProcState::READY, globalTick);
+            self.enqueueReady(p.id);
+        }
+        runningPid = -1;
+        quantumUsed = 0;
+    }
+}
+
+#endif // SCHEDULER_ENGINE_H
@@ -0,0 +1,37 @@
+#include "SchedulerPolicy.h"
+#include "SchedulerCFS.h"
+#include "SchedulerRT.h"
+#include "SchedulerSMP.h"
+
+// ========== SELECCIÓN DE POLÍTICA - IMPLEMENTACIÓN ==========
+
+SchedulerCore *makeScheduler(SchedPolicy policy, MemoryManager &mm, ProducerConsumer &pc,
+                             int quantum, int numCpus) {
+    switch (policy) {
+        case SchedPolicy::SJF: return new SchedulerSJF(mm, pc, false);
+        case SchedPolicy::SRTF: return new SchedulerSJF(mm, pc, true);
+        case SchedPolicy::PRIORITY: return new SchedulerPriority(mm, pc, quantum);
+        case SchedPolicy::MLFQ: return new SchedulerMLFQ(mm, pc);
+        case SchedPolicy::CFS: return new SchedulerCFS(mm, pc);
+        case SchedPolicy::EDF: return new SchedulerRT(mm, pc, RTPolicy::EDF);
+        case SchedPolicy::RM: return new SchedulerRT(mm, pc, RTPolicy::RM);
+        case SchedPolicy::SMP: return new SchedulerSMP(mm, pc, numCpus, quantum);
+        case SchedPolicy::RR:
+        default: return new SchedulerRR(mm, pc, quantum);
+    }
+}
+
+const char *schedPolicyName(SchedPolicy policy) {
+    switch (policy) {
+        case SchedPolicy::SJF: return "SJF";
+        case SchedPolicy::SRTF: return "SRTF";
+        case SchedPolicy::PRIORITY: return "Prioridad";
+        case SchedPolicy::MLFQ: return "MLFQ";
+        case SchedPolicy::CFS: return "CFS";
+        case SchedPolicy::EDF: return "EDF";
+        case SchedPolicy::RM: return "Rate Monotonic";
+        case SchedPolicy::SMP: return "SMP (Round Robin)";
+        case SchedPolicy::RR:
+        default: return "Round Robin";
+    }
+}
@@ -0,0 +1,374 @@
+#ifndef SCHEDULER_POLICY_H
+#define SCHEDULER_POLICY_H
+
+#include <queue>
+#include <vector>
+#include <utility>
+#include <climits>
+#include <functional>
+#include <algorithm>
+#include <unordered_map>
+#include "SchedulerEngine.h"
+
+// ========== POLÍTICAS DE PLANIFICACIÓN ==========
+/**
+ * Una política define la cola de listos y la selección del siguiente:
+ *   void push(const PCB &p);                      // p pasa a READY
+ *   void changed(const PCB &p);                   // cambió el trabajo de un READY
+ *   int  pickNext(const ProcessTable &procs);     // saca el siguiente (-1 = vacía)
+ *   bool empty() const;
+ *   int  timeSlice(const PCB &p) const;
+ *   bool preempts(const ProcessTable &procs, const PCB &running);
+ *   void save(SnapshotWriter &w, const ProcessTable &procs) const;  // cola de listos
+ *   bool load(SnapshotReader &r);                 // false si no es esta política
+ * Scheduler<Policy> la integra con el núcleo común sin despacho virtual.
+ */
+
+// ========== HEAP DE LISTOS CON BORRADO PEREZOSO ==========
+/**
+ * Min-heap por (clave, orden de llegada). Reinsertar un PID deja obsoleta
+ * su entrada anterior; las entradas obsoletas o de procesos que ya no
+ * están READY se descartan al llegar a la cima.
+ */
+class LazyReadyHeap {
+private:
+    struct Entry {              // Sin relleno: se guarda tal cual en el snapshot
+        long long seq;
+        int key;
+        int pid;
+        bool operator>(const Entry &o) const {
+            return key != o.key ? key > o.key : seq > o.seq;
+        }
+    };
+
+    long long enqueueSeq = 0;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    std::unordered_map<int, long long> latestSeq;  // pid -> seq de su entrada vigente
+
+    void dropStale(const ProcessTable &procs) {
+        while (!heap.empty()) {
+            const Entry &e = heap.top();
+            const PCB *p = procs.find(e.pid);
+            auto it = latestSeq.find(e.pid);
+            bool current = it != latestSeq.end() && it->second == e.seq;
+            if (current && p && p->state == ProcState::READY) return;
+            if (current) latestSeq.erase(it);
+            heap.pop();
+        }
+    }
+
+public:
+    void push(int key, int pid) {
+        latestSeq[pid] = enqueueSeq;
+        heap.push({enqueueSeq++, key, pid});
+    }
+
+    int pop(const ProcessTable &procs) {
+        dropStale(procs);
+        if (heap.empty()) return -1;
+        int pid = heap.top().pid;
+        heap.pop();
+        latestSeq.erase(pid);
+        return pid;
+    }
+
+    // Clave del mejor listo (INT_MAX si no hay)
+    int topKey(const ProcessTable &procs) {
+        dropStale(procs);
+        return heap.empty() ? INT_MAX : heap.top().key;
+    }
+
+    bool empty() const { return heap.empty(); }
+
+    // Snapshot: el arreglo del heap tal cual y las entradas vigentes
+    // ordenadas por PID (la salida no depende del orden del hash)
+    void save(SnapshotWriter &w) const {
+        w.put(enqueueSeq);
+        w.putVector(HeapContainer<decltype(heap)>::of(heap));
+        std::vector<std::pair<int, long long>> seqs(latestSeq.begin(), latestSeq.end());
+        std::sort(seqs.begin(), seqs.end());
+        w.put<uint64_t>(seqs.size());
+        for (const auto &e : seqs) {
+            w.put(e.first);
+            w.put(e.second);
+        }
+    }
+
+    bool load(SnapshotReader &r) {
+        LazyReadyHeap next;
+        auto &entries = HeapContainer<decltype(heap)>::of(next.heap);
+        uint64_t n;
+        if (!r.get(next.enqueueSeq) || !r.getVector(entries)) return false;
+        if (!std::is_heap(entries.begin(), entries.end(), std::greater<Entry>())) return r.fail();
+        if (!r.getCount(n, sizeof(int) + sizeof(long long))) return false;
+        for (uint64_t i = 0; i < n; i++) {
+            int pid;
+            long long seq;
+            if (!r.get(pid) || !r.get(seq)) return false;
+            next.latestSeq[pid] = seq;
+        }
+        *this = std::move(next);
+        return true;
+    }
+};
+
+// ========== ROUND ROBIN ==========
+/**
+ * Cola FIFO y quantum fijo. Mismo borrado perezoso que LazyReadyHeap: un
+ * PID que sale de READY (suspend, sleep) y vuelve se reencola al final y
+ * su entrada anterior queda obsoleta.
+ */
+class RRPolicy {
+private:
+    struct Entry {
+        int pid;
+        long long seq;
+    };
+
+    int quantum;
+    long long enqueueSeq = 0;
+    std::queue<Entry> readyQueue;
+    std::unordered_map<int, long long> latestSeq;  // pid -> seq de su entrada vigente
+
+    bool isCurrent(const ProcessTable &procs, const Entry &e) const {
+        const PCB *p = procs.find(e.pid);
+        auto it = latestSeq.find(e.pid);
+        return it != latestSeq.end() && it->second == e.seq && p &&
+               p->state == ProcState::READY;
+    }
+
+public:
+    explicit RRPolicy(int q = DEFAULT_QUANTUM) : quantum(q) {}
+
+    void push(const PCB &p) {
+        latestSeq[p.id] = enqueueSeq;
+        readyQueue.push({p.id, enqueueSeq++});
+    }
+    void changed(const PCB &) {}
+
+    int pickNext(const ProcessTable &procs) {
+        // Descartar obsoletas y procesos que ya no están READY
+        while (!readyQueue.empty()) {
+            const Entry &e = readyQueue.front();
+            if (isCurrent(procs, e)) break;
+            auto it = latestSeq.find(e.pid);
+            if (it != latestSeq.end() && it->second == e.seq) latestSeq.erase(it);
+            readyQueue.pop();
+        }
+        if (readyQueue.empty()) return -1;
+        int pid = readyQueue.front().pid;
+        readyQueue.pop();
+        latestSeq.erase(pid);
+        return pid;
+    }
+
+    bool empty() const { return readyQueue.empty(); }
+    int timeSlice(const PCB &) const { return quantum; }
+    bool preempts(const ProcessTable &, const PCB &) { return false; }
+
+    // Snapshot: sólo los PIDs vigentes en orden de cola (las entradas
+    // obsoletas se descartarían igual al llegar al frente)
+    void save(SnapshotWriter &w, const ProcessTable &procs) const {
+        w.put(SNAPSHOT_POLICY_RR);
+        w.put(quantum);
+        std::queue<Entry> q = readyQueue;
+        std::vector<int> pids;
+        for (; !q.empty(); q.pop())
+            if (isCurrent(procs, q.front())) pids.push_back(q.front().pid);
+        w.putVector(pids);
+    }
+
+    bool load(SnapshotReader &r) {
+        uint32_t tag;
+        int q;
+        std::vector<int> pids;
+        if (!r.get(tag) || tag != SNAPSHOT_POLICY_RR) return r.fail();
+        if (!r.get(q) || !r.getVector(pids)) return false;
+        quantum = q;
+        readyQueue = std::queue<Entry>();
+        latestSeq.clear();
+        enqueueSeq = 0;
+        for (int pid : pids) {
+            latestSeq[pid] = enqueueSeq;
+            readyQueue.push({pid, enqueueSeq++});
+        }
+        return true;
+    }
+};
+
+// ========== SJF (Shortest Job First) ==========
+/**
+ * Heap binario por trabajo restante (burst del PCB, o suma de los hilos
+ * vivos); empates por orden de llegada a la cola.
+ * - Modo no expropiativo (SJF) o expropiativo SRTF (Shortest Remaining
+ *   Time First): un proceso listo con menos trabajo restante desaloja
+ *   al que está en CPU.
+ */
+class SJFPolicy {
+private:
+    bool preemptive;
+    LazyReadyHeap readyHeap;
+
+    static int remainingWork(const PCB &p) {
+        if (!p.hasThreads) return p.burstRemaining;
+        int work = 0;
+        for (auto &t : p.threads)
+            if (t.state != ThreadState::THREAD_TERMINATED) work += t.burstRemaining;
+        return work;
+    }
+
+public:
+    explicit SJFPolicy(bool srtf = false) : preemptive(srtf) {}
+
+    void push(const PCB &p) { readyHeap.push(remainingWork(p), p.id); }
+    // Reinsertar con la clave nueva; la entrada anterior queda obsoleta
+    void changed(const PCB &p) { push(p); }
+    int pickNext(const ProcessTable &procs) { return readyHeap.pop(procs); }
+    bool empty() const { return readyHeap.empty(); }
+    int timeSlice(const PCB &) const { return INT_MAX; }
+
+    bool preempts(const ProcessTable &procs, const PCB &running) {
+        return preemptive && readyHeap.topKey(procs) < remainingWork(running);
+    }
+
+    bool isPreemptive() const { return preemptive; }
+
+    void save(SnapshotWriter &w, const ProcessTable &) const {
+        w.put(SNAPSHOT_POLICY_SJF);
+        w.put(preemptive);
+        readyHeap.save(w);
+    }
+
+    bool load(SnapshotReader &r) {
+        uint32_t tag;
+        bool srtf;
+        if (!r.get(tag) || tag != SNAPSHOT_POLICY_SJF) return r.fail();
+        if (!r.get(srtf) || !readyHeap.load(r)) return false;
+        preemptive = srtf;
+        return true;
+    }
+};
+
+// ========== PRIORIDAD ESTÁTICA ==========
+/**
+ * Prioridad fija por PCB::nice (-20 = la más alta), Round-Robin con
+ * quantum entre procesos de igual prioridad. Expropiativa: un listo con
+ * mayor prioridad desaloja al que está en CPU.
+ */
+class PriorityPolicy {
+private:
+    int quantum;
+    bool preemptive;
+    LazyReadyHeap readyHeap;
+
+public:
+    explicit PriorityPolicy(int q = DEFAULT_QUANTUM, bool preempt = true)
+        : quantum(q), preemptive(preempt) {}
+
+    void push(const PCB &p) { readyHeap.push(p.nice, p.id); }
+    void changed(const PCB &p) { push(p); }
+    int pickNext(const ProcessTable &procs) { return readyHeap.pop(procs); }
+    bool empty() const { return readyHeap.empty(); }
+    int timeSlice(const PCB &) const { return quantum; }
+
+    bool preempts(const ProcessTable &procs, const PCB &running) {
+        return preemptive && readyHeap.topKey(procs) < running.nice;
+    }
+
+    void save(SnapshotWriter &w, const ProcessTable &) const {
+        w.put(SNAPSHOT_POLICY_PRIORITY);
+        w.put(quantum);
+        w.put(preemptive);
+        readyHeap.save(w);
+    }
+
+    bool load(SnapshotReader &r) {
+        uint32_t tag;
+        int q;
+        bool preempt;
+        if (!r.get(tag) || tag != SNAPSHOT_POLICY_PRIORITY) return r.fail();
+        if (!r.get(q) || !r.get(preempt) || !readyHeap.load(r)) return false;
+        quantum = q;
+        preemptive = preempt;
+        return true;
+    }
+};
+
+// ========== SCHEDULER PARAMETRIZADO POR POLÍTICA ==========
+/**
+ * Planificador de un CPU cuya cola de listos y selección vienen de Policy.
+ * Los hooks son final: tick()/runTicks() instancian el motor de
+ * SchedulerEngine.h con este tipo y el bucle de ticks queda sin llamadas
+ * virtuales. Los argumentos extra del constructor se pasan a la política.
+ */
+template <class Policy>
+class Scheduler final : public SchedulerCore {
+private:
+    friend class SchedulerCore;
+    Policy policy;
+
+    void enqueueReady(int pid) override { policy.push(processes.at(pid)); }
+    void readyWorkChanged(int pid) override { policy.changed(processes.at(pid)); }
+    bool readyQueueEmpty() const override { return policy.empty(); }
+    int timeSlice(const PCB &p) const override { return policy.timeSlice(p); }
+
+    void scheduleNext() override {
+        int pid = policy.pickNext(processes);
+        if (pid == -1) return;
+        PCB &p = processes.at(pid);
+        if (p.burstRemaining > 0) {
+            runningPid = pid;
+            quantumUsed = 0;
+        } else terminateProcess(p);
+    }
+
+    bool shouldPreempt(const PCB &running) override {
+        return policy.preempts(processes, running);
+    }
+
+    // Hooks que estas políticas no usan: definidos aquí para que se inlineen
+    void quantumExpired(PCB &) override {}
+    void threadReady(PCB &, int) override {}
+    void dequeueReady(int) override {}
+    void accountRuntime(PCB &, int) override {}
+    bool jobCompleted(PCB &) override { return false; }
+    int nextTimer() const override { return INT_MAX; }
+    void onTimer() override {}
+
+    bool savePolicyState(SnapshotWriter &w) const override {
+        policy.save(w, processes);
+        return true;
+    }
+
+    bool loadPolicyState(SnapshotReader &r) override { return policy.load(r); }
+
+public:
+    template <class... Args>
+    Scheduler(MemoryManager &mm, ProducerConsumer &pc, Args &&...args)
+        : SchedulerCore(mm, pc), policy(std::forward<Args>(args)...) {}
+
+    void tick() override { tickImpl(*this); }
+    void runTicks(int n) override { runTicksImpl(*this, n); }
+
+    const Policy &getPolicy() const { return policy; }
+};
+
+using SchedulerRR = Scheduler<RRPolicy>;
+using SchedulerSJF = Scheduler<SJFPolicy>;
+using SchedulerPriority = Scheduler<PriorityPolicy>;
+
+// ========== SELECCIÓN DE POLÍTICA EN TIEMPO DE EJECUCIÓN ==========
+// SchedulerCore es la interfaz borrada: una llamada virtual por tick()/
+// runTicks(), el bucle interno queda resuelto en compilación.
+// El valor se guarda en las trazas: agregar al final.
+enum class SchedPolicy { RR, SJF, SRTF, PRIORITY, MLFQ, CFS, EDF, RM, SMP };
+
+const int SCHED_POLICY_COUNT = (int)SchedPolicy::SMP + 1;
+
+// El llamador es dueño del planificador devuelto. quantum rige para RR,
+// Prioridad y SMP; numCpus sólo para SMP.
+SchedulerCore *makeScheduler(SchedPolicy policy, MemoryManager &mm, ProducerConsumer &pc,
+                             int quantum = DEFAULT_QUANTUM, int numCpus = 4);
+const char *schedPolicyName(SchedPolicy policy);
+
+#endif // SCHEDULER_POLICY_H
@@ -0,0 +1,404 @@
+#include "SchedulerRT.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+// ========== MÉTRICAS DE TAREA ==========
+
+RTTaskStats::RTTaskStats()
+    : wcet(0), period(0), deadline(0), released(0), completed(0), missed(0), aborted(0),
+      minResponse(INT_MAX), maxResponse(0), sumResponse(0), sumSqResponse(0) {}
+
+void RTTaskStats::recordCompletion(int response, int late) {
+    completed++;
+    if (late > 0) missed++;
+    minResponse = std::min(minResponse, response);
+    maxResponse = std::max(maxResponse, response);
+    sumResponse += response;
+    sumSqResponse += (long long)response * response;
+    lateness[late]++;
+}
+
+// ========== SCHEDULER RT - IMPLEMENTACIÓN ==========
+
+SchedulerRT::SchedulerRT(MemoryManager &mm, ProducerConsumer &pc, RTPolicy pol)
+    : SchedulerCore(mm, pc), policy(pol), admissionControl(true), enqueueSeq(0) {}
+
+int SchedulerRT::priorityKey(const PCB &p) const {
+    // Los aperiódicos quedan detrás de cualquier tarea periódica
+    if (p.period <= 0) return INT_MAX;
+    return policy == RTPolicy::EDF ? p.absDeadline : p.period;
+}
+
+void SchedulerRT::dropStale() {
+    // Borrado perezoso: una entrada es vigente si su proceso sigue READY
+    // y es la última que se insertó para ese PID
+    while (!readyHeap.empty()) {
+        const ReadyEntry &e = readyHeap.top();
+        const PCB *p = processes.find(e.pid);
+        auto it = latestSeq.find(e.pid);
+        bool current = it != latestSeq.end() && it->second == e.seq;
+        if (current && p && p->state == ProcState::READY) return;
+        if (current) latestSeq.erase(it);
+        readyHeap.pop();
+    }
+}
+
+void SchedulerRT::enqueueReady(int pid) {
+    latestSeq[pid] = enqueueSeq;
+    readyHeap.push({enqueueSeq++, priorityKey(processes.at(pid)), pid});
+}
+
+void SchedulerRT::readyWorkChanged(int pid) {
+    // Reinsertar con la clave nueva; la entrada anterior queda obsoleta
+    enqueueReady(pid);
+}
+
+bool SchedulerRT::readyQueueEmpty() const { return readyHeap.empty(); }
+
+int SchedulerRT::timeSlice(const PCB &) const { return INT_MAX; }
+
+void SchedulerRT::scheduleNext() {
+    dropStale();
+    if (readyHeap.empty()) return;
+
+    int pid = readyHeap.top().pid;
+    readyHeap.pop();
+    latestSeq.erase(pid);
+    PCB &p = processes.at(pid);
+    if (p.burstRemaining > 0) {
+        runningPid = pid;
+        quantumUsed = 0;
+    } else if (p.period > 0) {
+        // Reanudada entre activaciones: espera el próximo trabajo
+        p.setState(ProcState::WAITING, globalTick);
+    } else terminateProcess(p);
+}
+
+bool SchedulerRT::shouldPreempt(const PCB &running) {
+    dropStale();
+    return !readyHeap.empty() && readyHeap.top().key < priorityKey(running);
+}
+
+bool SchedulerRT::jobCompleted(PCB &p) {
+    if (p.period <= 0 || p.hasThreads) return false;
+    stats[p.id].recordCompletion(globalTick - p.jobRelease, globalTick - p.absDeadline);
+    return true;
+}
+
+void SchedulerRT::releaseJob(int pid, int tick) {
+    PCB *pp = processes.find(pid);
+    if (!pp || pp->state == ProcState::TERMINATED) return;
+
+    PCB &p = *pp;
+    releases.push({tick + p.period, pid});
+    if (p.state == ProcState::SUSPENDED) return;   // Activación perdida
+
+    RTTaskStats &st = stats[pid];
+    if (p.burstRemaining > 0) {
+        // El trabajo anterior no terminó: se aborta
+        st.missed++;
+        st.aborted++;
+    }
+    p.burstRemaining = p.wcet;
+    p.jobRelease = tick;
+    p.absDeadline = tick + p.relDeadline;
+    st.released++;
+
+    if (p.state == ProcState::WAITING) {
+        p.setState(ProcState::READY, globalTick);
+        enqueueReady(pid);
+    } else if (p.state == ProcState::READY) {
+        readyWorkChanged(pid);
+    }
+}
+
+int SchedulerRT::nextTimer() const {
+    return releases.empty() ? INT_MAX : releases.top().first;
+}
+
+void SchedulerRT::onTimer() {
+    while (!releases.empty() && releases.top().first <= globalTick) {
+        std::pair<int, int> r = releases.top();
+        releases.pop();
+        releaseJob(r.second, r.first);
+    }
+}
+
+// ========== ADMISIÓN ==========
+
+int SchedulerRT::createPeriodicTask(int wcet, int period, int deadline, int pages) {
+    if (deadline <= 0) deadline = period;
+    if (wcet <= 0 || period <= 0 || deadline > period || wcet > deadline) return -1;
+    if (admissionControl && !admits(wcet, period, deadline)) return -1;
+
+    int pid = createProcess(wcet, pages);
+    PCB &p = processes.at(pid);
+    p.period = period;
+    p.relDeadline = deadline;
+    p.wcet = wcet;
+    p.jobRelease = globalTick;
+    p.absDeadline = globalTick + deadline;
+
+    RTTaskStats &st = stats[pid];
+    st.wcet = wcet;
+    st.period = period;
+    st.deadline = deadline;
+    st.released = 1;
+
+    enqueueReady(pid);      // Reinsertar con la clave de tiempo real
+    releases.push({globalTick + period, pid});
+    return pid;
+}
+
+bool SchedulerRT::admits(int wcet, int period, int deadline) const {
+    if (deadline <= 0) deadline = period;
+    if (wcet <= 0 || period <= 0) return false;
+
+    // Densidad C/min(D,T): exacta para EDF con D = T, suficiente con D < T
+    double u = (double)wcet / std::min(deadline, period);
+    double sum = u, prod = 1 + u;
+    int n = 1;
+    for (const PCB &p : processes) {
+        if (p.period <= 0 || p.state == ProcState::TERMINATED) continue;
+        double ui = (double)p.wcet / std::min(p.relDeadline, p.period);
+        sum += ui;
+        prod *= 1 + ui;
+        n++;
+    }
+
+    const double eps = 1e-9;
+    if (policy == RTPolicy::EDF) return sum <= 1 + eps;
+    return sum <= n * (std::pow(2.0, 1.0 / n) - 1) + eps || prod <= 2 + eps;
+}
+
+void SchedulerRT::setAdmissionControl(bool enabled) { admissionControl = enabled; }
+
+RTPolicy SchedulerRT::getPolicy() const { return policy; }
+
+double SchedulerRT::getUtilization() const {
+    double sum = 0;
+    for (const PCB &p : processes)
+        if (p.period > 0 && p.state != ProcState::TERMINATED)
+            sum += (double)p.wcet / std::min(p.relDeadline, p.period);
+    return sum;
+}
+
+double SchedulerRT::getUtilizationBound() const {
+    if (policy == RTPolicy::EDF) return 1.0;
+    int n = 0;
+    for (const PCB &p : processes)
+        if (p.period > 0 && p.state != ProcState::TERMINATED) n++;
+    return n > 0 ? n * (std::pow(2.0, 1.0 / n) - 1) : 1.0;
+}
+
+int SchedulerRT::getDeadlineMisses() const {
+    int misses = 0;
+    for (const auto &e : stats) misses += e.second.missed;
+    return misses;
+}
+
+// ========== SNAPSHOT ==========
+// Heap de listos tal cual; seq vigentes, activaciones y métricas por PID
+// en orden, así la salida no depende del orden del hash
+
+bool SchedulerRT::savePolicyState(SnapshotWriter &w) const {
+    w.put(SNAPSHOT_POLICY_RT);
+    w.put(policy);
+    w.put(admissionControl);
+    w.put(enqueueSeq);
+    w.putVector(HeapContainer<decltype(readyHeap)>::of(readyHeap));
+    std::vector<std::pair<int, long long>> seqs(latestSeq.begin(), latestSeq.end());
+    std::sort(seqs.begin(), seqs.end());
+    w.put<uint64_t>(seqs.size());
+    for (const auto &e : seqs) {
+        w.put(e.first);
+        w.put(e.second);
+    }
+    std::vector<std::pair<int, int>> pending = HeapContainer<decltype(releases)>::of(releases);
+    std::sort(pending.begin(), pending.end());
+    w.put<uint64_t>(pending.size());
+    for (const auto &e : pending) {
+        w.put(e.first);
+        w.put(e.second);
+    }
+    w.put<uint64_t>(stats.size());
+    for (const auto &e : stats) {
+        const RTTaskStats &st = e.second;
+        w.put(e.first);
+        w.put(st.wcet);
+        w.put(st.period);
+        w.put(st.deadline);
+        w.put(st.released);
+        w.put(st.completed);
+        w.put(st.missed);
+        w.put(st.aborted);
+        w.put(st.minResponse);
+        w.put(st.maxResponse);
+        w.put(st.sumResponse);
+        w.put(st.sumSqResponse);
+        w.put<uint64_t>(st.lateness.size());
+        for (const auto &l : st.lateness) {
+            w.put(l.first);
+            w.put(l.second);
+        }
+    }
+    return true;
+}
+
+bool SchedulerRT::loadPolicyState(SnapshotReader &r) {
+    uint32_t tag;
+    RTPolicy pol;
+    bool admission;
+    long long seq;
+    std::vector<ReadyEntry> entries;
+    uint64_t n;
+    if (!r.get(tag) || tag != SNAPSHOT_POLICY_RT) return r.fail();
+    if (!r.get(pol) || !r.get(admission) || !r.get(seq) || !r.getVector(entries)) return false;
+    if (pol > RTPolicy::RM || !std::is_heap(entries.begin(), entries.end(), std::greater<ReadyEntry>()))
+        return r.fail();
+
+    std::unordered_map<int, long long> seqs;
+    if (!r.getCount(n, sizeof(int) + sizeof(long long))) return false;
+    for (uint64_t i = 0; i < n; i++) {
+        int pid;
+        long long s;
+        if (!r.get(pid) || !r.get(s)) return false;
+        seqs[pid] = s;
+    }
+    std::vector<std::pair<int, int>> pending;
+    if (!r.getCount(n, 2 * sizeof(int))) return false;
+    for (uint64_t i = 0; i < n; i++) {
+        int tick, pid;
+        if (!r.get(tick) || !r.get(pid)) return false;
+        pending.push_back({tick, pid});
+    }
+    std::map<int, RTTaskStats> nextStats;
+    if (!r.getCount(n, 10 * sizeof(int) + 2 * sizeof(long long))) return false;
+    for (uint64_t i = 0; i < n; i++) {
+        int pid;
+        uint64_t buckets;
+        RTTaskStats st;
+        if (!r.get(pid) || !r.get(st.wcet) || !r.get(st.period) || !r.get(st.deadline) ||
+            !r.get(st.released) || !r.get(st.completed) || !r.get(st.missed) ||
+            !r.get(st.aborted) || !r.get(st.minResponse) || !r.get(st.maxResponse) ||
+            !r.get(st.sumResponse) || !r.get(st.sumSqResponse) ||
+            !r.getCount(buckets, 2 * sizeof(int))) return false;
+        for (uint64_t b = 0; b < buckets; b++) {
+            int late, jobs;
+            if (!r.get(late) || !r.get(jobs)) return false;
+            st.lateness[late] = jobs;
+        }
+        if (!nextStats.emplace(pid, std::move(st)).second) return r.fail();
+    }
+
+    policy = pol;
+    admissionControl = admission;
+    enqueueSeq = seq;
+    HeapContainer<decltype(readyHeap)>::of(readyHeap) = std::move(entries);
+    latestSeq = std::move(seqs);
+    releases = decltype(releases)(std::greater<std::pair<int, int>>(), std::move(pending));
+    stats = std::move(nextStats);
+    return true;
+}
+
+// ========== REPORTES ==========
+
+static int latenessPercentile(const std::map<int, int> &dist, int total, double q) {
+    int rank = std::max(1, (int)std::ceil(q * total));
+    int seen = 0;
+    for (const auto &e : dist) {
+        seen += e.second;
+        if (seen >= rank) return e.first;
+    }
+    return dist.empty() ? 0 : dist.rbegin()->first;
+}
+
+void SchedulerRT::showRealTime() const {
+    const char *name = policy == RTPolicy::EDF ? "EDF" : "RM ";
+
+    std::cout << "\n┌─────────────────────────────────────────────────────────────────────────────────────┐\n";
+    std::cout << "│                    TIEMPO REAL (" << name << ") - PLAZOS POR TAREA                             │\n";
+    std::cout << "├─────┬─────┬─────┬─────┬───────┬───────┬───────┬───────┬───────────────────┬────────┤\n";
+    std::cout << "│ PID │  C  │  T  │  D  │ Activ │ Compl │ Perd. │ Abort │ Resp mín/prom/máx │ Jitter │\n";
+    std::cout << "├─────┼─────┼─────┼─────┼───────┼───────┼───────┼───────┼───────────────────┼────────┤\n";
+
+    std::map<int, int> lateness;
+    int totalDone = 0, totalReleased = 0, totalMissed = 0;
+    for (const auto &e : stats) {
+        const RTTaskStats &st = e.second;
+        std::cout << "│ " << std::setw(3) << e.first
+                  << " │ " << std::setw(3) << st.wcet
+                  << " │ " << std::setw(3) << st.period
+                  << " │ " << std::setw(3) << st.deadline
+                  << " │ " << std::setw(5) << st.released
+                  << " │ " << std::setw(5) << st.completed
+                  << " │ " << std::setw(5) << st.missed
+                  << " │ " << std::setw(5) << st.aborted << " │ ";
+        if (st.completed > 0) {
+            double mean = (double)st.sumResponse / st.completed;
+            std::cout << std::setw(4) << st.minResponse << " / "
+                      << std::setw(5) << std::fixed << std::setprecision(1) << mean << " / "
+                      << std::setw(3) << st.maxResponse
+                      << " │ " << std::setw(6) << (st.maxResponse - st.minResponse) << " │\n";
+        } else {
+            std::cout << std::setw(17) << "-" << " │ " << std::setw(6) << "-" << " │\n";
+        }
+        for (const auto &l : st.lateness) lateness[l.first] += l.second;
+        totalDone += st.completed;
+        totalReleased += st.released;
+        totalMissed += st.missed;
+    }
+    std::cout << "└─────┴─────┴─────┴─────┴───────┴───────┴───────┴───────┴───────────────────┴────────┘\n";
+
+    std::cout << "Densidad: " << std::fixed << std::setprecision(3) << getUtilization()
+              << " | Cota " << (policy == RTPolicy::EDF ? "EDF" : "RM (Liu-Layland)")
+              << ": " << getUtilizationBound()
+              << " | Plazos incumplidos: " << totalMissed << "/" << totalReleased
+              << " (" << std::setprecision(1)
+              << (totalReleased > 0 ? 100.0 * totalMissed / totalReleased : 0) << " %)\n";
+
+    // Jitter como desviación estándar del tiempo de respuesta
+    for (const auto &e : stats) {
+        const RTTaskStats &st = e.second;
+        if (st.completed < 2) continue;
+        double mean = (double)st.sumResponse / st.completed;
+        double var = (double)st.sumSqResponse / st.completed - mean * mean;
+        std::cout << "  PID " << std::setw(3) << e.first << ": σ respuesta = "
+                  << std::setprecision(2) << std::sqrt(std::max(0.0, var)) << " ticks\n";
+    }
+
+    // Distribución del retraso (fin - plazo absoluto) de los trabajos completados
+    std::cout << "\n┌────────────────────────────────────────────────────────┐\n";
+    std::cout << "│   DISTRIBUCIÓN DEL RETRASO (fin - plazo, completados)  │\n";
+    std::cout << "└────────────────────────────────────────────────────────┘\n";
+    if (totalDone == 0) {
+        std::cout << "Sin trabajos completados.\n";
+        return;
+    }
+    std::cout << "p50: " << latenessPercentile(lateness, totalDone, 0.50)
+              << " | p90: " << latenessPercentile(lateness, totalDone, 0.90)
+              << " | p99: " << latenessPercentile(lateness, totalDone, 0.99)
+              << " | máx: " << lateness.rbegin()->first << " ticks\n";
+
+    // Hasta 10 rangos de igual ancho entre el mínimo y el máximo
+    int lo = lateness.begin()->first, hi = lateness.rbegin()->first;
+    int width = std::max(1, (hi - lo + 10) / 10);
+    std::vector<int> buckets((hi - lo) / width + 1, 0);
+    for (const auto &l : lateness) buckets[(l.first - lo) / width] += l.second;
+    int maxCount = *std::max_element(buckets.begin(), buckets.end());
+    for (size_t i = 0; i < buckets.size(); i++) {
+        int from = lo + (int)i * width, to = from + width - 1;
+        std::cout << "[" << std::setw(5) << from << "," << std::setw(5) << to << "] │";
+        int bars = buckets[i] * 40 / maxCount;
+        for (int b = 0; b < bars; b++) std::cout << (to > 0 ? "▓" : "█");
+        std::cout << " " << buckets[i] << "\n";
+    }
+}
+
+void SchedulerRT::showStats() const {
+    SchedulerCore::showStats();
+    showRealTime();
+}
@@ -0,0 +1,97 @@
+#ifndef SCHEDULER_RT_H
+#define SCHEDULER_RT_H
+
+#include <map>
+#include "Scheduler.h"
+
+enum class RTPolicy { EDF, RM };
+
+// ========== MÉTRICAS DE UNA TAREA PERIÓDICA ==========
+struct RTTaskStats {
+    int wcet;
+    int period;
+    int deadline;
+    int released;               // Trabajos activados
+    int completed;              // Trabajos terminados
+    int missed;                 // Plazos incumplidos (tardíos + abortados)
+    int aborted;                // Sin terminar al llegar la siguiente activación
+    int minResponse;
+    int maxResponse;
+    long long sumResponse;
+    long long sumSqResponse;
+    std::map<int, int> lateness;    // Retraso (fin - plazo) -> trabajos
+
+    RTTaskStats();
+    void recordCompletion(int response, int late);
+};
+
+// ========== SCHEDULER DE TIEMPO REAL (EDF / RM) ==========
+/**
+ * Planificador expropiativo para tareas periódicas (PCB::period,
+ * relDeadline, wcet). Cada activación repone el burst del PCB con su WCET
+ * y fija el plazo absoluto; al completar el trabajo el proceso queda en
+ * WAITING hasta la siguiente activación.
+ * - EDF: heap de plazos absolutos, gana el más cercano.
+ * - RM: prioridad fija por período (menor período = mayor prioridad).
+ * - Los procesos aperiódicos corren en segundo plano, detrás de las tareas.
+ * - Control de admisión por cota de utilización (densidad C/min(D,T)):
+ *   EDF <= 1; RM por cota de Liu-Layland n(2^(1/n) - 1) o hiperbólica
+ *   prod(U_i + 1) <= 2.
+ * - Un trabajo sin terminar al llegar la siguiente activación se aborta
+ *   y cuenta como plazo incumplido.
+ */
+class SchedulerRT : public SchedulerCore {
+private:
+    struct ReadyEntry {         // Sin relleno: se guarda tal cual en el snapshot
+        long long seq;
+        int key;
+        int pid;
+        bool operator>(const ReadyEntry &o) const {
+            return key != o.key ? key > o.key : seq > o.seq;
+        }
+    };
+
+    RTPolicy policy;
+    bool admissionControl;
+    long long enqueueSeq;
+    std::priority_queue<ReadyEntry, std::vector<ReadyEntry>, std::greater<ReadyEntry>> readyHeap;
+    std::unordered_map<int, long long> latestSeq;  // pid -> seq de su entrada vigente
+    // Próximas activaciones: (tick, pid)
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>,
+                        std::greater<std::pair<int, int>>> releases;
+    std::map<int, RTTaskStats> stats;              // pid -> métricas (orden de PID en reportes)
+
+    int priorityKey(const PCB &p) const;
+    void dropStale();
+    void releaseJob(int pid, int tick);
+    void enqueueReady(int pid) override;
+    void scheduleNext() override;
+    bool readyQueueEmpty() const override;
+    int timeSlice(const PCB &p) const override;
+    bool shouldPreempt(const PCB &running) override;
+    void readyWorkChanged(int pid) override;
+    bool jobCompleted(PCB &p) override;
+    int nextTimer() const override;
+    void onTimer() override;
+    bool savePolicyState(SnapshotWriter &w) const override;
+    bool loadPolicyState(SnapshotReader &r) override;
+
+public:
+    SchedulerRT(MemoryManager &mm, ProducerConsumer &pc, RTPolicy pol = RTPolicy::EDF);
+
+    // deadline 0 = plazo igual al período. Devuelve -1 si la admisión falla.
+    int createPeriodicTask(int wcet, int period, int deadline = 0, int pages = 4) override;
+    bool admits(int wcet, int period, int deadline) const;
+    void setAdmissionControl(bool enabled);
+
+    RTPolicy getPolicy() const;
+    double getUtilization() const;         // Densidad de las tareas vivas
+    double getUtilizationBound() const;    // Cota de la política para las tareas vivas
+    int getDeadlineMisses() const;
+
+    // Estadísticas (incluye métricas de tiempo real)
+    void showStats() const override;
+    void showRealTime() const;
+};
+
+#endif // SCHEDULER_RT_H
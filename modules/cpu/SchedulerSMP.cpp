@@ -0,0 +1,490 @@
+#include "SchedulerSMP.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+// ========== SCHEDULER SMP - IMPLEMENTACIÓN ==========
+
+SchedulerSMP::SchedulerSMP(MemoryManager &mm, ProducerConsumer &pc, int numCpus, int q, int balanceEvery)
+    : SchedulerCore(mm, pc), quantum(std::max(1, q)), balanceInterval(balanceEvery) {
+    if (numCpus < 1) numCpus = 1;
+    if (numCpus > MAX_CPUS) numCpus = MAX_CPUS;
+    cpus.resize(numCpus, CPU{{}, {-1, 0}, 0, 0, 0, 0, 0, 0});
+    // El motor de eventos de SchedulerCore asume una sola CPU
+    eventDriven = false;
+}
+
+uint64_t SchedulerSMP::allCpusMask() const {
+    return cpus.size() >= 64 ? ~0ULL : (1ULL << cpus.size()) - 1;
+}
+
+bool SchedulerSMP::isQueueable(const Task &t) const {
+    const PCB *p = processes.find(t.pid);
+    // timerId != -1: llegada pendiente o dormido
+    if (!p || p->state == ProcState::TERMINATED || p->state == ProcState::SUSPENDED ||
+        p->timerId != -1)
+        return false;
+    if (t.tid == 0) return !p->hasThreads && p->state == ProcState::READY;
+    return p->hasThreads && t.tid <= (int)p->threads.size() &&
+           p->threads[t.tid - 1].state == ThreadState::THREAD_READY;
+}
+
+int SchedulerSMP::pickCpu(const PCB &p, long long key) const {
+    // Preferir la última CPU (caché caliente); si no, la menos cargada
+    auto it = lastCpu.find(key);
+    if (it != lastCpu.end() && allowed(p, it->second)) return it->second;
+
+    int best = 0;
+    size_t bestLoad = SIZE_MAX;
+    for (size_t c = 0; c < cpus.size(); c++) {
+        if (!allowed(p, c)) continue;
+        size_t load = cpus[c].runQueue.size() + (cpus[c].current.pid != -1);
+        if (load < bestLoad) {
+            bestLoad = load;
+            best = c;
+        }
+    }
+    return best;
+}
+
+void SchedulerSMP::pushTask(const Task &t) {
+    long long key = taskKey(t.pid, t.tid);
+    if (queuedOn.count(key)) return;
+    int cpu = pickCpu(processes.at(t.pid), key);
+    cpus[cpu].runQueue.push_back(t);
+    queuedOn[key] = cpu;
+}
+
+void SchedulerSMP::enqueueReady(int pid) {
+    PCB &p = processes.at(pid);
+    if (!p.hasThreads) {
+        pushTask({pid, 0});
+        return;
+    }
+    for (int tid = p.readyHead; tid; tid = p.thread(tid).nextReady)
+        if (p.thread(tid).state == ThreadState::THREAD_READY) pushTask({pid, tid});
+    // Un PCB despertado puede no tener hilos ejecutables (p. ej. se bloqueó
+    // antes de crear sus hilos): su estado lo dictan los hilos
+    refreshState(p);
+}
+
+void SchedulerSMP::readyWorkChanged(int pid) { enqueueReady(pid); }
+
+void SchedulerSMP::threadReady(PCB &p, int tid) {
+    if (p.state != ProcState::SUSPENDED && p.state != ProcState::TERMINATED)
+        pushTask({p.id, tid});
+}
+
+bool SchedulerSMP::readyQueueEmpty() const { return queuedOn.empty(); }
+
+int SchedulerSMP::timeSlice(const PCB &) const { return quantum; }
+
+void SchedulerSMP::scheduleNext() {
+    for (size_t c = 0; c < cpus.size(); c++)
+        if (cpus[c].current.pid == -1) dispatch(c);
+}
+
+bool SchedulerSMP::dispatch(int cpu) {
+    CPU &c = cpus[cpu];
+    while (!c.runQueue.empty()) {
+        Task t = c.runQueue.front();
+        c.runQueue.pop_front();
+        queuedOn.erase(taskKey(t.pid, t.tid));
+        if (!isQueueable(t)) continue;
+
+        PCB &p = processes.at(t.pid);
+        if (t.tid == 0 && p.burstRemaining <= 0) {
+            // Igual que en una sola CPU: sin ráfaga restante se descarta
+            terminateProcess(p);
+            continue;
+        }
+        if (!allowed(p, cpu)) {
+            // La afinidad cambió mientras esperaba en esta cola
+            pushTask(t);
+            continue;
+        }
+
+        c.current = t;
+        c.quantumUsed = 0;
+        long long key = taskKey(t.pid, t.tid);
+        auto it = lastCpu.find(key);
+        if (it != lastCpu.end() && it->second != cpu) c.migrations++;
+        lastCpu[key] = cpu;
+
+        if (t.tid != 0) p.setThreadState(p.thread(t.tid), ThreadState::THREAD_RUNNING);
+        p.setState(ProcState::RUNNING, globalTick);
+        return true;
+    }
+    return steal(cpu);
+}
+
+bool SchedulerSMP::steal(int cpu) {
+    // Robar de la cola más larga, empezando por el final (lo más frío)
+    int victim = -1;
+    size_t longest = 0;
+    for (size_t c = 0; c < cpus.size(); c++) {
+        if ((int)c != cpu && cpus[c].runQueue.size() > longest) {
+            longest = cpus[c].runQueue.size();
+            victim = c;
+        }
+    }
+    if (victim == -1) return false;
+
+    std::deque<Task> &q = cpus[victim].runQueue;
+    for (int i = (int)q.size() - 1; i >= 0; i--) {
+        Task t = q[i];
+        if (!isQueueable(t) || !allowed(processes.at(t.pid), cpu)) continue;
+        q.erase(q.begin() + i);
+        long long key = taskKey(t.pid, t.tid);
+        queuedOn[key] = cpu;
+        cpus[cpu].runQueue.push_front(t);
+        cpus[cpu].steals++;
+        return dispatch(cpu);
+    }
+    return false;
+}
+
+void SchedulerSMP::balance() {
+    // Mover tareas de la cola más larga a la más corta mientras difieran en más de 1
+    for (size_t round = 0; round < cpus.size(); round++) {
+        int busiest = 0, idlest = 0;
+        for (size_t c = 1; c < cpus.size(); c++) {
+            if (cpus[c].runQueue.size() > cpus[busiest].runQueue.size()) busiest = c;
+            if (cpus[c].runQueue.size() < cpus[idlest].runQueue.size()) idlest = c;
+        }
+        if (cpus[busiest].runQueue.size() <= cpus[idlest].runQueue.size() + 1) return;
+
+        std::deque<Task> &q = cpus[busiest].runQueue;
+        bool moved = false;
+        for (int i = (int)q.size() - 1; i >= 0 && !moved; i--) {
+            Task t = q[i];
+            const PCB *p = processes.find(t.pid);
+            if (!p || !allowed(*p, idlest)) continue;
+            q.erase(q.begin() + i);
+            queuedOn[taskKey(t.pid, t.tid)] = idlest;
+            cpus[idlest].runQueue.push_back(t);
+            moved = true;
+        }
+        if (!moved) return;
+    }
+}
+
+void SchedulerSMP::release(int cpu) {
+    cpus[cpu].current = {-1, 0};
+    cpus[cpu].quantumUsed = 0;
+}
+
+void SchedulerSMP::validateCurrent(int cpu) {
+    Task t = cpus[cpu].current;
+    if (t.pid == -1) return;
+
+    PCB *pp = processes.find(t.pid);
+    if (!pp) {
+        release(cpu);
+        return;
+    }
+    PCB &p = *pp;
+    bool gone = p.state == ProcState::TERMINATED || p.state == ProcState::SUSPENDED ||
+                p.timerId != -1;
+    bool becameThreaded = t.tid == 0 && p.hasThreads;
+    if (!gone && !becameThreaded && allowed(p, cpu)) return;
+
+    // Sacar la tarea de la CPU (muerto, suspendido, con hilos nuevos o sin afinidad)
+    release(cpu);
+    if (t.tid != 0) {
+        Thread &th = p.thread(t.tid);
+        if (th.state == ThreadState::THREAD_RUNNING)
+            p.setThreadState(th, ThreadState::THREAD_READY);
+    }
+    if (gone) return;
+
+    if (t.tid == 0 && !becameThreaded) p.setState(ProcState::READY, globalTick);
+    if (becameThreaded) enqueueReady(p.id);
+    else pushTask(t);
+    refreshState(p);
+}
+
+void SchedulerSMP::refreshState(PCB &p) {
+    // El estado de un PCB con hilos resume el de sus hilos
+    if (!p.hasThreads || p.state == ProcState::TERMINATED ||
+        p.state == ProcState::SUSPENDED || p.state == ProcState::NEW || p.timerId != -1) return;
+
+    ProcState next = p.runningThreads > 0 ? ProcState::RUNNING
+                   : hasRunnableThread(p) ? ProcState::READY : ProcState::WAITING;
+    if (next != p.state) p.setState(next, globalTick);
+}
+
+void SchedulerSMP::terminateProcess(PCB &p) {
+    // También vía killProcess: se olvida la última CPU de todos sus hilos
+    SchedulerCore::terminateProcess(p);
+    for (int tid = 0; tid <= (int)p.threads.size(); tid++) lastCpu.erase(taskKey(p.id, tid));
+    clockStamp.erase(p.id);
+}
+
+void SchedulerSMP::runTask(int cpu, std::vector<int> &touched) {
+    CPU &c = cpus[cpu];
+    Task t = c.current;
+    PCB &p = processes.at(t.pid);
+    c.busyTicks++;
+    p.cpuTime++;
+
+    // Acceso a memoria (los hilos comparten el espacio de direcciones del PCB)
+    bool pf = memManager.access(p.id, p.nextPageToAccess,
+                                accessIsWrite(p.id, p.nextPageToAccess, accessParams));
+    if (pf) p.pageFaults++;
+    p.pageAccesses++;
+    p.nextPageToAccess = p.access.next(p.nextPageToAccess, p.numPages, accessParams);
+
+    bool sync = p.type == ProcType::PRODUCER || p.type == ProcType::CONSUMER;
+
+    if (t.tid == 0) {
+        p.burstRemaining--;
+        if (sync) {
+            int waiterId;
+            int result = syncOperation(p, 0, waiterId);
+            if (result == 0) {
+                if (p.type == ProcType::PRODUCER) p.itemsProduced++;
+                else p.itemsConsumed++;
+            } else {
+                p.setState(ProcState::WAITING, globalTick);
+                p.blockedOnSemaphore = result - 1;
+                p.waiterId = waiterId;
+                release(cpu);
+                return;
+            }
+        }
+
+        if (p.burstRemaining <= 0) {
+            terminateProcess(p);
+            release(cpu);
+        } else if (++c.quantumUsed >= quantum) {
+            p.setState(ProcState::READY, globalTick);
+            release(cpu);
+            pushTask(t);
+        }
+        return;
+    }
+
+    Thread &th = p.thread(t.tid);
+    touched.push_back(p.id);
+    th.burstRemaining--;
+
+    if (sync) {
+        int waiterId;
+        int result = syncOperation(p, th.tid, waiterId);
+        if (result == 0) {
+            if (p.type == ProcType::PRODUCER) { th.itemsProduced++; p.itemsProduced++; }
+            else { th.itemsConsumed++; p.itemsConsumed++; }
+        } else {
+            p.setThreadState(th, ThreadState::THREAD_WAITING);
+            th.blockedOnSemaphore = result - 1;
+            th.waiterId = waiterId;
+            release(cpu);
+            return;
+        }
+    }
+
+    // threadClock avanza una vez por tick aunque corran varios hilos del PCB
+    int &stamp = clockStamp[p.id];
+    if (stamp != globalTick) {
+        p.threadClock++;
+        stamp = globalTick;
+    }
+
+    if (th.burstRemaining <= 0) {
+        p.setThreadState(th, ThreadState::THREAD_TERMINATED);
+        lastCpu.erase(taskKey(t.pid, t.tid));
+        release(cpu);
+
+        if (p.liveThreads == 0) {
+            p.burstRemaining = 0;
+            terminateProcess(p);
+        }
+    } else if (++c.quantumUsed >= quantum) {
+        p.setThreadState(th, ThreadState::THREAD_READY);
+        release(cpu);
+        pushTask(t);
+    }
+}
+
+void SchedulerSMP::tick() {
+    fireTimer();
+    if (balanceInterval > 0 && globalTick % balanceInterval == 0) balance();
+
+    // Despacho en todas las CPUs antes de ejecutar: los hilos de un mismo
+    // PCB arrancan con el mismo threadClock
+    for (size_t c = 0; c < cpus.size(); c++) {
+        validateCurrent(c);
+        if (cpus[c].current.pid == -1) dispatch(c);
+    }
+    for (auto &c : cpus) {
+        int len = c.runQueue.size();
+        c.queueLenSum += len;
+        c.maxQueueLen = std::max(c.maxQueueLen, len);
+    }
+
+    globalTick++;
+
+    std::vector<int> touched;
+    for (size_t c = 0; c < cpus.size(); c++)
+        if (cpus[c].current.pid != -1) runTask(c, touched);
+    for (int pid : touched) {
+        PCB *p = processes.find(pid);
+        if (p) refreshState(*p);
+    }
+
+    // DESBLOQUEO: mover a READY los procesos/threads despertados por signal
+    unblockWaitingProcesses();
+}
+
+void SchedulerSMP::runTicks(int n) {
+    int target = globalTick + n;
+    while (globalTick < target) {
+        bool idle = queuedOn.empty();
+        for (auto &c : cpus)
+            if (c.current.pid != -1) idle = false;
+        if (idle) {
+            // Sin tareas listas ni en CPU nadie puede hacer signal: saltar al
+            // final o al próximo temporizador (llegada, sleep, timeout)
+            globalTick = std::min(target, timers.nextExpiry());
+            if (globalTick == target) break;
+        }
+        tick();
+    }
+}
+
+bool SchedulerSMP::setAffinity(int pid, uint64_t mask) {
+    PCB *p = processes.find(pid);
+    mask &= allCpusMask();
+    if (!p || !mask) return false;
+    // Las tareas fuera de su máscara migran en el próximo despacho
+    p->affinity = mask;
+    return true;
+}
+
+int SchedulerSMP::getCpuCount() const { return cpus.size(); }
+
+// ========== SNAPSHOT ==========
+// Colas y tarea en curso de cada CPU; queuedOn se deriva de las colas.
+// lastCpu y clockStamp van ordenados: la salida no depende del hash.
+
+bool SchedulerSMP::savePolicyState(SnapshotWriter &w) const {
+    w.put(SNAPSHOT_POLICY_SMP);
+    w.put(quantum);
+    w.put(balanceInterval);
+    w.put<uint32_t>(cpus.size());
+    for (const CPU &c : cpus) {
+        w.putVector(std::vector<Task>(c.runQueue.begin(), c.runQueue.end()));
+        w.put(c.current);
+        w.put(c.quantumUsed);
+        w.put(c.busyTicks);
+        w.put(c.queueLenSum);
+        w.put(c.maxQueueLen);
+        w.put(c.migrations);
+        w.put(c.steals);
+    }
+    std::vector<std::pair<long long, int>> last(lastCpu.begin(), lastCpu.end());
+    std::sort(last.begin(), last.end());
+    w.put<uint64_t>(last.size());
+    for (const auto &e : last) {
+        w.put(taskOf(e.first));
+        w.put(e.second);
+    }
+    std::vector<std::pair<int, int>> stamps(clockStamp.begin(), clockStamp.end());
+    std::sort(stamps.begin(), stamps.end());
+    w.put<uint64_t>(stamps.size());
+    for (const auto &e : stamps) {
+        w.put(e.first);
+        w.put(e.second);
+    }
+    return true;
+}
+
+bool SchedulerSMP::loadPolicyState(SnapshotReader &r) {
+    uint32_t tag, count;
+    int q, every;
+    if (!r.get(tag) || tag != SNAPSHOT_POLICY_SMP) return r.fail();
+    if (!r.get(q) || !r.get(every) || !r.get(count)) return false;
+    if (q < 1 || count < 1 || count > MAX_CPUS) return r.fail();
+
+    std::vector<CPU> nextCpus(count);
+    std::unordered_map<long long, int> nextQueued;
+    for (uint32_t i = 0; i < count; i++) {
+        CPU &c = nextCpus[i];
+        std::vector<Task> queue;
+        if (!r.getVector(queue) || !r.get(c.current) || !r.get(c.quantumUsed) ||
+            !r.get(c.busyTicks) || !r.get(c.queueLenSum) || !r.get(c.maxQueueLen) ||
+            !r.get(c.migrations) || !r.get(c.steals)) return false;
+        for (const Task &t : queue)
+            if (t.pid < 0 || t.tid < 0 || !nextQueued.emplace(taskKey(t.pid, t.tid), i).second)
+                return r.fail();
+        c.runQueue.assign(queue.begin(), queue.end());
+    }
+
+    std::unordered_map<long long, int> nextLast;
+    std::unordered_map<int, int> nextStamps;
+    uint64_t n;
+    if (!r.getCount(n, sizeof(Task) + sizeof(int))) return false;
+    for (uint64_t i = 0; i < n; i++) {
+        Task t;
+        int cpu;
+        if (!r.get(t) || !r.get(cpu)) return false;
+        if (t.pid < 0 || t.tid < 0 || cpu < 0 || cpu >= (int)count) return r.fail();
+        nextLast[taskKey(t.pid, t.tid)] = cpu;
+    }
+    if (!r.getCount(n, 2 * sizeof(int))) return false;
+    for (uint64_t i = 0; i < n; i++) {
+        int pid, stamp;
+        if (!r.get(pid) || !r.get(stamp)) return false;
+        nextStamps[pid] = stamp;
+    }
+
+    quantum = q;
+    balanceInterval = every;
+    cpus = std::move(nextCpus);
+    queuedOn = std::move(nextQueued);
+    lastCpu = std::move(nextLast);
+    clockStamp = std::move(nextStamps);
+    return true;
+}
+
+void SchedulerSMP::showCpuStats() const {
+    std::cout << "\n┌─────┬──────────────┬─────────┬──────────┬──────────┬──────────┬─────────┬───────┐\n";
+    std::cout << "│ CPU │   En CPU     │ Util. % │ Cola act │ Cola prom│ Cola máx │ Migrac. │ Robos │\n";
+    std::cout << "├─────┼──────────────┼─────────┼──────────┼──────────┼──────────┼─────────┼───────┤\n";
+
+    long long busy = 0;
+    int migrations = 0, steals = 0;
+    for (size_t i = 0; i < cpus.size(); i++) {
+        const CPU &c = cpus[i];
+        std::string cur = "-";
+        if (c.current.pid != -1) {
+            cur = "PID " + std::to_string(c.current.pid);
+            if (c.current.tid != 0) cur += " T" + std::to_string(c.current.tid);
+        }
+        double util = globalTick > 0 ? 100.0 * c.busyTicks / globalTick : 0;
+        double avgLen = globalTick > 0 ? (double)c.queueLenSum / globalTick : 0;
+
+        std::cout << "│ " << std::setw(3) << i
+                  << " │ " << std::setw(12) << cur
+                  << " │ " << std::setw(7) << std::fixed << std::setprecision(1) << util
+                  << " │ " << std::setw(8) << c.runQueue.size()
+                  << " │ " << std::setw(8) << std::setprecision(2) << avgLen
+                  << " │ " << std::setw(8) << c.maxQueueLen
+                  << " │ " << std::setw(7) << c.migrations
+                  << " │ " << std::setw(5) << c.steals << " │\n";
+        busy += c.busyTicks;
+        migrations += c.migrations;
+        steals += c.steals;
+    }
+    std::cout << "└─────┴──────────────┴─────────┴──────────┴──────────┴──────────┴─────────┴───────┘\n";
+
+    double total = globalTick > 0 ? 100.0 * busy / ((double)globalTick * cpus.size()) : 0;
+    std::cout << "Utilización total: " << std::fixed << std::setprecision(1) << total << " %"
+              << " | Migraciones: " << migrations << " | Robos: " << steals << "\n";
+}
+
+void SchedulerSMP::showStats() const {
+    SchedulerCore::showStats();
+    showCpuStats();
+}
@@ -0,0 +1,96 @@
+#ifndef SCHEDULER_SMP_H
+#define SCHEDULER_SMP_H
+
+#include <deque>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "Scheduler.h"
+
+// ========== SCHEDULER SMP (MULTINÚCLEO) ==========
+/**
+ * Planificador Round-Robin para N CPUs simuladas.
+ * - Cada CPU tiene su propia cola de ejecución y su quantum.
+ * - La unidad planificable es la tarea: un PCB sin hilos o un hilo
+ *   concreto de un PCB, así los hilos de un proceso corren en paralelo.
+ * - Afinidad: PCB::affinity limita las CPUs en que pueden correr sus tareas.
+ * - Una tarea vuelve a la última CPU en que corrió si su afinidad lo permite;
+ *   si no, va a la cola menos cargada.
+ * - Balanceo: una CPU ociosa roba trabajo de la cola más larga y cada
+ *   balanceInterval ticks se reparten las colas desbalanceadas.
+ * - Estadísticas por núcleo: utilización, migraciones y longitud de cola.
+ */
+class SchedulerSMP : public SchedulerCore {
+public:
+    static const int MAX_CPUS = 64;     // Un bit de PCB::affinity por CPU
+
+private:
+    struct Task {
+        int pid;
+        int tid;                        // 0 = PCB sin hilos
+    };
+
+    struct CPU {
+        std::deque<Task> runQueue;
+        Task current;                   // pid -1 = CPU ociosa
+        int quantumUsed;
+        long long busyTicks;
+        long long queueLenSum;          // Suma por tick (para el promedio)
+        int maxQueueLen;
+        int migrations;                 // Tareas que llegaron desde otra CPU
+        int steals;                     // Tareas robadas a otras colas
+    };
+
+    int quantum;
+    int balanceInterval;
+    std::vector<CPU> cpus;
+    std::unordered_map<long long, int> queuedOn;    // tarea -> CPU en cuya cola está
+    std::unordered_map<long long, int> lastCpu;     // tarea -> última CPU en que corrió
+    std::unordered_map<int, int> clockStamp;        // pid -> tick en que avanzó su threadClock
+
+    // 32 bits para el TID: un proceso puede tener más de 65535 hilos
+    static long long taskKey(int pid, int tid) { return ((long long)pid << 32) | (uint32_t)tid; }
+    static Task taskOf(long long key) { return {(int)(key >> 32), (int)(key & 0xFFFFFFFF)}; }
+    bool allowed(const PCB &p, int cpu) const { return (p.affinity >> cpu) & 1ULL; }
+    uint64_t allCpusMask() const;
+
+    bool isQueueable(const Task &t) const;
+    int pickCpu(const PCB &p, long long key) const;
+    void pushTask(const Task &t);
+    bool dispatch(int cpu);
+    bool steal(int cpu);
+    void balance();
+    void release(int cpu);
+    void validateCurrent(int cpu);
+    void runTask(int cpu, std::vector<int> &touched);
+    void refreshState(PCB &p);
+
+    void terminateProcess(PCB &p) override;
+    void enqueueReady(int pid) override;
+    void scheduleNext() override;
+    bool readyQueueEmpty() const override;
+    int timeSlice(const PCB &p) const override;
+    void readyWorkChanged(int pid) override;
+    void threadReady(PCB &p, int tid) override;
+    bool savePolicyState(SnapshotWriter &w) const override;
+    bool loadPolicyState(SnapshotReader &r) override;
+
+public:
+    SchedulerSMP(MemoryManager &mm, ProducerConsumer &pc, int numCpus = 4,
+                 int q = DEFAULT_QUANTUM, int balanceEvery = 8);
+
+    // Ejecución
+    void tick() override;
+    void runTicks(int n) override;
+
+    // Afinidad (máscara de CPUs; bit i = CPU i)
+    bool setAffinity(int pid, uint64_t mask);
+
+    // Visualización
+    void showCpuStats() const;
+    void showStats() const override;
+
+    int getCpuCount() const;
+};
+
+#endif // SCHEDULER_SMP_H
@@ -2,18 +2,27 @@
 #define SYNCHRONIZATION_H
 
 #include <queue>
+#include <deque>
 #include <vector>
+#include <unordered_map>
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include "../snapshot/SnapshotIO.h"
 
 // Constantes
 const int DEFAULT_BUFFER_SIZE = 5;
 
+// Identificadores de semáforo (valor de blockedOnSemaphore)
+const int SEM_EMPTY = 0;
+const int SEM_FULL = 1;
+const int SEM_MUTEX = 2;
+
 // ========== SEMÁFORO ==========
 class Semaphore {
 private:
     int value;
-    std::queue<int> waitingQueue; // cola FIFO de PIDs
+    std::deque<int> waitingQueue; // cola FIFO de PIDs
 
 public:
     Semaphore(int val = 1) : value(val) {}
@@ -23,15 +32,17 @@ public:
             value--;
             return true;
         } else {
-            waitingQueue.push(pid);
+            waitingQueue.push_back(pid);
             return false;
         }
     }
 
+    // Si hay procesos esperando, el permiso pasa directamente al primero
+    // (se devuelve su PID) en lugar de incrementar el valor.
     int signal() {
         if (!waitingQueue.empty()) {
             int pid = waitingQueue.front();
-            waitingQueue.pop();
+            waitingQueue.pop_front();
             return pid;
         } else {
             value++;
@@ -39,52 +50,114 @@ public:
         }
     }
 
+    // Retira un PID de la cola de espera (p. ej. proceso terminado)
+    bool cancel(int pid) {
+        auto it = std::find(waitingQueue.begin(), waitingQueue.end(), pid);
+        if (it == waitingQueue.end()) return false;
+        waitingQueue.erase(it);
+        return true;
+    }
+
     int getValue() const { return value; }
     bool hasWaiting() const { return !waitingQueue.empty(); }
+    int getWaitingCount() const { return waitingQueue.size(); }
+
+    // Snapshot: valor y cola de espera
+    void save(SnapshotWriter &w) const {
+        w.put(value);
+        w.putVector(std::vector<int>(waitingQueue.begin(), waitingQueue.end()));
+    }
+
+    bool load(SnapshotReader &r) {
+        int v;
+        std::vector<int> q;
+        if (!r.get(v) || !r.getVector(q)) return false;
+        value = v;
+        waitingQueue.assign(q.begin(), q.end());
+        return true;
+    }
 };
 
 // ========== PRODUCTOR-CONSUMIDOR ==========
+/**
+ * Buffer acotado con semáforos empty/full/mutex y modelo de bloqueo real:
+ * - tryProduce/tryConsume devuelven 0 si la operación se completó, o
+ *   (semáforo + 1) si el llamador quedó estacionado en la cola de ese semáforo.
+ * - Cada signal() que entrega el permiso a un waiter completa su operación
+ *   pendiente en cadena y lo anota en la lista de despertados (popWakeup).
+ * El costo de desbloqueo es proporcional al número de despertares.
+ */
 class ProducerConsumer {
 private:
-    std::vector<int> buffer;
+    std::deque<int> buffer;
     int maxSize;
     Semaphore empty;
     Semaphore full;
     Semaphore mutex;
+    std::unordered_map<int, int> pendingItems; // productor estacionado -> ítem
+    std::queue<int> wakeups;                   // waiters cuya operación se completó
+
+    // Tras depositar (o retirar) un ítem, entregar permisos a los waiters
+    // estacionados alternando consumidores y productores hasta agotarlos.
+    void handOff(bool afterDeposit) {
+        while (true) {
+            if (afterDeposit) {
+                int consumer = full.signal();
+                if (consumer == -1) return;
+                buffer.pop_front();
+                wakeups.push(consumer);
+            }
+            afterDeposit = true;
+
+            int producer = empty.signal();
+            if (producer == -1) return;
+            buffer.push_back(pendingItems[producer]);
+            pendingItems.erase(producer);
+            wakeups.push(producer);
+        }
+    }
 
 public:
     ProducerConsumer(int size = DEFAULT_BUFFER_SIZE)
         : maxSize(size), empty(size), full(0), mutex(1) {}
 
-    bool tryProduce(int pid, int item) {
-        if (!empty.tryWait(pid)) return false;
-        if (!mutex.tryWait(pid)) {
-            empty.signal();
-            return false;
+    int tryProduce(int pid, int item) {
+        if (!empty.tryWait(pid)) {
+            pendingItems[pid] = item;
+            return SEM_EMPTY + 1;
         }
-        
+        // La sección crítica es atómica dentro de un tick: mutex nunca compite
+        mutex.tryWait(pid);
         buffer.push_back(item);
         mutex.signal();
-        full.signal();
-        return true;
+        handOff(true);
+        return 0;
     }
 
-    bool tryConsume(int pid, int &item) {
-        if (!full.tryWait(pid)) return false;
-        if (!mutex.tryWait(pid)) {
-            full.signal();
-            return false;
-        }
-        
-        if (!buffer.empty()) {
-            item = buffer.front();
-            buffer.erase(buffer.begin());
-        }
+    int tryConsume(int pid, int &item) {
+        if (!full.tryWait(pid)) return SEM_FULL + 1;
+        mutex.tryWait(pid);
+        item = buffer.front();
+        buffer.pop_front();
         mutex.signal();
-        empty.signal();
+        handOff(false);
+        return 0;
+    }
+
+    // Siguiente waiter despertado cuya operación ya se completó
+    bool popWakeup(int &pid) {
+        if (wakeups.empty()) return false;
+        pid = wakeups.front();
+        wakeups.pop();
         return true;
     }
 
+    // Retira un waiter estacionado (p. ej. proceso terminado)
+    void cancel(int pid) {
+        if (empty.cancel(pid)) pendingItems.erase(pid);
+        full.cancel(pid);
+    }
+
     void showBuffer() const {
         std::cout << "Buffer [" << buffer.size() << "/" << maxSize << "]: ";
         for (int item : buffer) std::cout << item << " ";
@@ -92,6 +165,47 @@ public:
         std::cout << "Semáforos -> empty:" << empty.getValue() 
                   << " full:" << full.getValue() 
                   << " mutex:" << mutex.getValue() << "\n";
+        std::cout << "En espera -> empty:" << empty.getWaitingCount()
+                  << " full:" << full.getWaitingCount() << "\n";
+    }
+
+    // Snapshot: buffer, semáforos, ítems pendientes y despertados
+    void save(SnapshotWriter &w) const {
+        w.put(maxSize);
+        w.putVector(std::vector<int>(buffer.begin(), buffer.end()));
+        empty.save(w);
+        full.save(w);
+        mutex.save(w);
+        std::vector<std::pair<int, int>> pending(pendingItems.begin(), pendingItems.end());
+        std::sort(pending.begin(), pending.end());
+        w.put<uint64_t>(pending.size());
+        for (const auto &e : pending) {
+            w.put(e.first);
+            w.put(e.second);
+        }
+        std::queue<int> q = wakeups;
+        std::vector<int> woken;
+        for (; !q.empty(); q.pop()) woken.push_back(q.front());
+        w.putVector(woken);
+    }
+
+    bool load(SnapshotReader &r) {
+        ProducerConsumer next;
+        std::vector<int> items, woken;
+        uint64_t pending;
+        if (!r.get(next.maxSize) || !r.getVector(items)) return false;
+        if (!next.empty.load(r) || !next.full.load(r) || !next.mutex.load(r)) return false;
+        if (!r.getCount(pending, 2 * sizeof(int))) return false;
+        for (uint64_t i = 0; i < pending; i++) {
+            int pid, item;
+            if (!r.get(pid) || !r.get(item)) return false;
+            next.pendingItems[pid] = item;
+        }
+        if (!r.getVector(woken)) return false;
+        next.buffer.assign(items.begin(), items.end());
+        for (int pid : woken) next.wakeups.push(pid);
+        *this = std::move(next);
+        return true;
     }
 
     int getSize() const { return buffer.size(); }
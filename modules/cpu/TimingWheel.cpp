@@ -0,0 +1,155 @@
+#include "TimingWheel.h"
+#include "../snapshot/SnapshotIO.h"
+
+// ========== RUEDA JERÁRQUICA ==========
+
+TimingWheel::TimingWheel() { clear(0); }
+
+void TimingWheel::clear(int now) {
+    nodes.clear();
+    freeNodes.clear();
+    std::fill(head, head + LEVELS * SLOTS, -1);
+    std::fill(tail, tail + LEVELS * SLOTS, -1);
+    for (auto &level : occupied) std::fill(level, level + SLOTS / 64, 0);
+    current = now;
+    nextDue = INT_MAX;
+    count = 0;
+    nextSeq = 0;
+}
+
+int TimingWheel::place(int expires) const {
+    // Nivel más bajo cuyo índice está a menos de una vuelta del actual
+    for (int level = 0; level < LEVELS - 1; level++) {
+        int shift = SLOT_BITS * level;
+        if ((expires >> shift) - (current >> shift) < SLOTS)
+            return level * SLOTS + ((expires >> shift) & (SLOTS - 1));
+    }
+    int shift = SLOT_BITS * (LEVELS - 1);
+    return (LEVELS - 1) * SLOTS + ((expires >> shift) & (SLOTS - 1));
+}
+
+void TimingWheel::link(int id) {
+    // Ordenado por seq: una alta directa va al final; lo que baja en una
+    // cascada puede ser anterior a lo que ya estaba en la ranura
+    Node &n = nodes[id];
+    int s = n.slot;
+    int after = tail[s];
+    while (after != -1 && nodes[after].seq > n.seq) after = nodes[after].prev;
+    n.prev = after;
+    n.next = after == -1 ? head[s] : nodes[after].next;
+    if (n.next == -1) tail[s] = id;
+    else nodes[n.next].prev = id;
+    if (after == -1) head[s] = id;
+    else nodes[after].next = id;
+    occupied[s / SLOTS][(s % SLOTS) >> 6] |= 1ULL << (s & 63);
+}
+
+void TimingWheel::unlink(int id) {
+    Node &n = nodes[id];
+    int s = n.slot;
+    if (n.prev == -1) head[s] = n.next;
+    else nodes[n.prev].next = n.next;
+    if (n.next == -1) tail[s] = n.prev;
+    else nodes[n.next].prev = n.prev;
+    if (head[s] == -1) occupied[s / SLOTS][(s % SLOTS) >> 6] &= ~(1ULL << (s & 63));
+}
+
+void TimingWheel::cascade(int level) {
+    int s = level * SLOTS + ((current >> (SLOT_BITS * level)) & (SLOTS - 1));
+    int id = head[s];
+    head[s] = tail[s] = -1;
+    occupied[level][(s % SLOTS) >> 6] &= ~(1ULL << (s & 63));
+    while (id != -1) {
+        int next = nodes[id].next;
+        nodes[id].slot = place(nodes[id].entry.expires);
+        link(id);
+        id = next;
+    }
+}
+
+// Distancia (1..SLOTS) desde 'index' hasta la próxima ranura ocupada; -1 si no hay
+static int nextOccupied(const uint64_t *bits, int index) {
+    // Recorre index+1 .. index+SLOTS por palabras (la vuelta incluye la propia ranura)
+    for (int d = 1; d <= TimingWheel::SLOTS;) {
+        int slot = (index + d) & (TimingWheel::SLOTS - 1);
+        uint64_t word = bits[slot >> 6] >> (slot & 63);
+        if (word) {
+            d += __builtin_ctzll(word);
+            return d <= TimingWheel::SLOTS ? d : -1;
+        }
+        d += 64 - (slot & 63);
+    }
+    return -1;
+}
+
+int TimingWheel::computeNextDue() const {
+    if (count == 0) return INT_MAX;
+    long long best = LLONG_MAX;
+    for (int level = 0; level < LEVELS; level++) {
+        int shift = SLOT_BITS * level;
+        int d = nextOccupied(occupied[level], (current >> shift) & (SLOTS - 1));
+        if (d < 0) continue;
+        // Nivel 0: el vencimiento exacto; los demás: el inicio de la ranura
+        long long t = (((long long)current >> shift) + d) << shift;
+        best = std::min(best, t);
+    }
+    return (int)std::min<long long>(best, INT_MAX);
+}
+
+int TimingWheel::add(int now, int expires, TimerKind kind, int pid, int arg) {
+    if (count == 0 && now > current) current = now;
+    expires = std::max(expires, now);
+    int id;
+    if (!freeNodes.empty()) {
+        id = freeNodes.back();
+        freeNodes.pop_back();
+    } else {
+        id = nodes.size();
+        nodes.push_back(Node());
+    }
+    Node &n = nodes[id];
+    n.entry = {expires, pid, arg, kind};
+    n.seq = nextSeq++;
+    n.slot = place(expires);
+    link(id);
+    count++;
+    int level = n.slot / SLOTS, shift = SLOT_BITS * level;
+    nextDue = std::min(nextDue, level == 0 ? expires : (expires >> shift) << shift);
+    return id;
+}
+
+void TimingWheel::cancel(int handle) {
+    if (handle < 0 || handle >= (int)nodes.size() || nodes[handle].slot == -1) return;
+    unlink(handle);
+    nodes[handle].slot = -1;
+    freeNodes.push_back(handle);
+    // nextDue queda como cota inferior; advance() la recalcula
+    if (--count == 0) nextDue = INT_MAX;
+}
+
+const TimerEntry &TimingWheel::get(int handle) const { return nodes[handle].entry; }
+int TimingWheel::size() const { return count; }
+int TimingWheel::nextExpiry() const { return nextDue; }
+
+void TimingWheel::save(SnapshotWriter &w) const {
+    w.put<uint64_t>(count);
+    forEach([&w](int, const TimerEntry &e) {
+        w.put(e.expires);
+        w.put(e.pid);
+        w.put(e.arg);
+        w.put(e.kind);
+    });
+}
+
+bool TimingWheel::load(SnapshotReader &r, int now) {
+    uint64_t n;
+    if (!r.getCount(n, 3 * sizeof(int) + 1)) return false;
+    clear(now);
+    for (uint64_t i = 0; i < n; i++) {
+        TimerEntry e;
+        if (!r.get(e.expires) || !r.get(e.pid) || !r.get(e.arg) || !r.get(e.kind)) return false;
+        if (e.expires < now || e.kind > TimerKind::TIMEOUT) return r.fail();
+        add(now, e.expires, e.kind, e.pid, e.arg);
+    }
+    return true;
+}
@@ -0,0 +1,129 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <vector>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+
+class SnapshotWriter;
+class SnapshotReader;
+
+// ========== TEMPORIZADORES ==========
+enum class TimerKind : uint8_t {
+    ARRIVAL,        // Llegada programada de un proceso NEW
+    SLEEP,          // Fin de sleepProcess
+    TIMEOUT         // Espera en semáforo vencida; arg = waiterId
+};
+
+struct TimerEntry {
+    int expires;            // Tick global en que vence
+    int pid;
+    int arg;
+    TimerKind kind;
+};
+
+// ========== RUEDA JERÁRQUICA ==========
+/**
+ * Rueda de temporizadores de 4 niveles x 256 ranuras (cubre todo int).
+ * - Nivel 0: un tick por ranura; nivel L: 256^L ticks por ranura. Un
+ *   temporizador se guarda en el nivel más bajo que lo alcanza y baja de
+ *   nivel (cascada) cuando el reloj llega al inicio de su ranura.
+ * - add/cancel O(1): listas doblemente enlazadas sobre un pool de nodos.
+ * - nextExpiry() es una cota inferior del próximo trabajo (vencimiento o
+ *   cascada) calculada con bitmaps de ranuras ocupadas: los ticks sin
+ *   temporizadores ni siquiera se visitan.
+ * - Los que vencen en el mismo tick se disparan en orden de alta.
+ */
+class TimingWheel {
+public:
+    static const int LEVELS = 4;
+    static const int SLOT_BITS = 8;
+    static const int SLOTS = 1 << SLOT_BITS;
+
+private:
+    struct Node {
+        TimerEntry entry;
+        uint64_t seq;           // Orden de alta (desempate dentro del tick)
+        int slot;               // Ranura absoluta (nivel * SLOTS + índice); -1 = libre
+        int prev;
+        int next;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int> freeNodes;
+    int head[LEVELS * SLOTS];
+    int tail[LEVELS * SLOTS];
+    uint64_t occupied[LEVELS][SLOTS / 64];
+    int current;                // Último tick procesado
+    int nextDue;                // Cota inferior del próximo trabajo
+    int count;
+    uint64_t nextSeq;
+
+    void link(int id);
+    void unlink(int id);
+    int place(int expires) const;       // Ranura absoluta según current
+    int computeNextDue() const;
+    void cascade(int level);
+
+public:
+    TimingWheel();
+
+    void clear(int now = 0);
+    // Devuelve el handle. Vence al procesar el tick 'expires' (uno ya
+    // pasado se adelanta a now)
+    int add(int now, int expires, TimerKind kind, int pid, int arg = 0);
+    void cancel(int handle);
+    const TimerEntry &get(int handle) const;
+    int size() const;
+    int nextExpiry() const;     // INT_MAX si está vacía
+
+    // Dispara en orden todos los vencidos hasta 'now' (inclusive)
+    template <class Fire> void advance(int now, Fire &&fire);
+    // Visita los pendientes en orden de alta: f(handle, entry)
+    template <class Visit> void forEach(Visit &&visit) const;
+
+    // Snapshot: los pendientes en orden de alta
+    void save(SnapshotWriter &w) const;
+    bool load(SnapshotReader &r, int now);
+};
+
+template <class Fire>
+void TimingWheel::advance(int now, Fire &&fire) {
+    while (count > 0 && nextDue <= now) {
+        current = nextDue;
+        // Las ranuras superiores que empiezan en este tick bajan de nivel
+        for (int level = 1; level < LEVELS; level++) {
+            if (current & ((1 << (SLOT_BITS * level)) - 1)) break;
+            cascade(level);
+        }
+        int s = current & (SLOTS - 1);
+        int id = head[s];
+        head[s] = tail[s] = -1;
+        occupied[0][s >> 6] &= ~(1ULL << (s & 63));
+        while (id != -1) {
+            int next = nodes[id].next;
+            TimerEntry e = nodes[id].entry;
+            nodes[id].slot = -1;
+            freeNodes.push_back(id);
+            count--;
+            fire(e);
+            id = next;
+        }
+        // fire() pudo agregar otro para este mismo tick
+        nextDue = head[s] != -1 ? current : computeNextDue();
+    }
+    if (now > current) current = now;
+    nextDue = computeNextDue();
+}
+
+template <class Visit>
+void TimingWheel::forEach(Visit &&visit) const {
+    std::vector<std::pair<uint64_t, int>> order;
+    for (int id = 0; id < (int)nodes.size(); id++)
+        if (nodes[id].slot != -1) order.push_back({nodes[id].seq, id});
+    std::sort(order.begin(), order.end());
+    for (const auto &o : order) visit(o.second, nodes[o.second].entry);
+}
+
+#endif // TIMING_WHEEL_H
@@ -1,4 +1,5 @@
 #include "DiskScheduler.h"
+#include "../snapshot/SnapshotIO.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
@@ -209,3 +210,31 @@ void DiskScheduler::reset() {
     accessHistory.clear();
     direction = 1;
 }
+
+// ========== SNAPSHOT ==========
+
+void DiskScheduler::save(SnapshotWriter &w) const {
+    w.put(algorithm);
+    w.put(maxCylinder);
+    w.put(headPosition);
+    w.put(direction);
+    w.put(totalMovement);
+    w.putVector(std::vector<int>(requestQueue.begin(), requestQueue.end()));
+    w.putVector(accessHistory);
+}
+
+bool DiskScheduler::load(SnapshotReader &r) {
+    DiskAlgo algo;
+    int maxCyl, head, dir, movement;
+    std::vector<int> queue, history;
+    if (!r.get(algo) || !r.get(maxCyl) || !r.get(head) || !r.get(dir) ||
+        !r.get(movement) || !r.getVector(queue) || !r.getVector(history)) return false;
+    algorithm = algo;
+    maxCylinder = maxCyl;
+    headPosition = head;
+    direction = dir;
+    totalMovement = movement;
+    requestQueue.assign(queue.begin(), queue.end());
+    accessHistory = std::move(history);
+    return true;
+}
@@ -5,6 +5,9 @@
 #include <vector>
 #include <string>
 
+class SnapshotWriter;
+class SnapshotReader;
+
 // ========== ALGORITMOS DE DISCO ==========
 enum class DiskAlgo { 
     FCFS,   // First Come First Served
@@ -44,6 +47,10 @@ public:
     int getHeadPosition() const;
     void reset();
     
+    // Snapshot binario (cola, cabezal y sentido de barrido)
+    void save(SnapshotWriter &w) const;
+    bool load(SnapshotReader &r);
+    
 private:
     int processNextFCFS();
     int processNextSSTF();
@@ -1,6 +1,8 @@
 #include "IOManager.h"
+#include "../snapshot/SnapshotIO.h"
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 
 // ========== IOREQUEST IMPLEMENTATION ==========
 bool IORequest::operator<(const IORequest& other) const {
@@ -113,3 +115,68 @@ double IOManager::getThroughput() const {
            ? (double)completedRequests / globalTime 
            : 0.0;
 }
+
+// ========== SNAPSHOT ==========
+
+static void saveDeviceMap(SnapshotWriter &w, const std::map<std::string, int> &m) {
+    w.put<uint64_t>(m.size());
+    for (const auto &e : m) {
+        w.putString(e.first);
+        w.put(e.second);
+    }
+}
+
+static bool loadDeviceMap(SnapshotReader &r, std::map<std::string, int> &m) {
+    uint64_t n;
+    if (!r.getCount(n, sizeof(uint32_t) + sizeof(int))) return false;
+    for (uint64_t i = 0; i < n; i++) {
+        std::string device;
+        int value;
+        if (!r.getString(device) || !r.get(value)) return false;
+        m[device] = value;
+    }
+    return true;
+}
+
+void IOManager::save(SnapshotWriter &w) const {
+    w.put(globalTime);
+    w.put(totalRequests);
+    w.put(completedRequests);
+    // Arreglo del heap en su orden interno: los empates de prioridad se
+    // resuelven igual tras restaurar
+    const auto &heap = HeapContainer<decltype(requestQueue)>::of(requestQueue);
+    w.put<uint64_t>(heap.size());
+    for (const IORequest &req : heap) {
+        w.put(req.pid);
+        w.put(req.priority);
+        w.putString(req.deviceType);
+        w.put(req.duration);
+        w.put(req.arrivalTime);
+    }
+    saveDeviceMap(w, deviceBusyTime);
+    saveDeviceMap(w, deviceUsedBy);
+}
+
+bool IOManager::load(SnapshotReader &r) {
+    int time, total, completed;
+    uint64_t n;
+    if (!r.get(time) || !r.get(total) || !r.get(completed)) return false;
+    if (!r.getCount(n, 4 * sizeof(int) + sizeof(uint32_t))) return false;
+    decltype(requestQueue) queue;
+    auto &heap = HeapContainer<decltype(requestQueue)>::of(queue);
+    heap.resize(n);
+    for (IORequest &req : heap) {
+        if (!r.get(req.pid) || !r.get(req.priority) || !r.getString(req.deviceType) ||
+            !r.get(req.duration) || !r.get(req.arrivalTime)) return false;
+    }
+    if (!std::is_heap(heap.begin(), heap.end(), std::less<IORequest>())) return r.fail();
+    std::map<std::string, int> busy, usedBy;
+    if (!loadDeviceMap(r, busy) || !loadDeviceMap(r, usedBy)) return false;
+    globalTime = time;
+    totalRequests = total;
+    completedRequests = completed;
+    requestQueue = std::move(queue);
+    deviceBusyTime = std::move(busy);
+    deviceUsedBy = std::move(usedBy);
+    return true;
+}
@@ -5,6 +5,9 @@
 #include <map>
 #include <string>
 
+class SnapshotWriter;
+class SnapshotReader;
+
 // ========== SOLICITUD DE E/S ==========
 struct IORequest {
     int pid;
@@ -44,6 +47,10 @@ public:
     double getAverageWaitTime() const;
     double getThroughput() const;
     
+    // Snapshot binario (cola de prioridad y ocupación de dispositivos)
+    void save(SnapshotWriter &w) const;
+    bool load(SnapshotReader &r);
+    
 private:
     void initializeDevices();
 };
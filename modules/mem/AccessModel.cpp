@@ -0,0 +1,152 @@
+#include "AccessModel.h"
+#include <cmath>
+#include <algorithm>
+
+AccessParams::AccessParams()
+    : wsPages(4), phaseLength(64), zipfSkew(1000), loopPages(8), loopIterations(4), stride(3),
+      writePercent(30) {}
+
+AccessStream::AccessStream() : rng(0), base(0), left(0), model(AccessModel::SEQUENTIAL) {}
+
+// ========== PRNG ==========
+
+static uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+uint64_t accessSeedFor(uint64_t seed, int pid) {
+    return mix64(seed + 0x9E3779B97F4A7C15ULL * (uint64_t)(uint32_t)pid);
+}
+
+bool accessIsWrite(int pid, int page, const AccessParams &prm) {
+    if (prm.writePercent <= 0) return false;
+    uint64_t h = mix64(accessSeedFor(0, pid) ^ (uint32_t)page);
+    return (int)((h >> 32) % 100) < prm.writePercent;
+}
+
+uint64_t AccessStream::nextRandom() {
+    rng += 0x9E3779B97F4A7C15ULL;
+    return mix64(rng);
+}
+
+int AccessStream::below(int n) {
+    return (int)(((nextRandom() >> 32) * (uint64_t)n) >> 32);
+}
+
+double AccessStream::unit() {
+    return ((nextRandom() >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+// ========== ZIPF POR RECHAZO-INVERSIÓN ==========
+// H es la integral de h(x) = x^-s; se invierte en forma cerrada y se acepta
+// el entero más cercano con una cota que casi nunca rechaza.
+
+static double helper1(double x) {   // log1p(x) / x
+    return std::fabs(x) > 1e-8 ? std::log1p(x) / x : 1 - x * (0.5 - x * (1.0 / 3 - 0.25 * x));
+}
+
+static double helper2(double x) {   // expm1(x) / x
+    return std::fabs(x) > 1e-8 ? std::expm1(x) / x : 1 + x * 0.5 * (1 + x / 3 * (1 + 0.25 * x));
+}
+
+static double zipfH(double x, double s) {
+    double logX = std::log(x);
+    return helper2((1 - s) * logX) * logX;
+}
+
+static double zipfHInverse(double x, double s) {
+    double t = std::max(-1.0, x * (1 - s));
+    return std::exp(helper1(t) * x);
+}
+
+static double zipfh(double x, double s) { return std::exp(-s * std::log(x)); }
+
+int AccessStream::zipf(int n, double s) {
+    if (n <= 1) return 1;
+    double hX1 = zipfH(1.5, s) - 1;
+    double hN = zipfH(n + 0.5, s);
+    double accept = 2 - zipfHInverse(zipfH(2.5, s) - zipfh(2, s), s);
+    while (true) {
+        double u = hN + unit() * (hX1 - hN);
+        double x = zipfHInverse(u, s);
+        int k = std::min(std::max((int)(x + 0.5), 1), n);
+        if (k - x <= accept || u >= zipfH(k + 0.5, s) - zipfh(k, s)) return k;
+    }
+}
+
+// ========== GENERACIÓN ==========
+
+void AccessStream::newPhase(int numPages, const AccessParams &prm) {
+    base = below(numPages);
+    left = std::max(1, prm.phaseLength);
+}
+
+int AccessStream::reset(AccessModel m, uint64_t seed, int numPages, const AccessParams &prm) {
+    model = m;
+    rng = seed;
+    base = 0;
+    left = 0;
+    numPages = std::max(1, numPages);
+    switch (model) {
+    case AccessModel::WORKING_SET:
+        newPhase(numPages, prm);
+        return (base + below(std::min(std::max(1, prm.wsPages), numPages))) % numPages;
+    case AccessModel::ZIPF:
+        return zipf(numPages, std::max(prm.zipfSkew, 10) / 1000.0) - 1;
+    case AccessModel::LOOP:
+        left = std::max(1, prm.loopIterations);
+        return 0;
+    case AccessModel::RANDOM:
+        return below(numPages);
+    default:
+        return 0;
+    }
+}
+
+int AccessStream::next(int page, int numPages, const AccessParams &prm) {
+    switch (model) {
+    case AccessModel::SEQUENTIAL:
+        return (page + 1) % numPages;
+
+    case AccessModel::WORKING_SET:
+        if (--left <= 0) newPhase(numPages, prm);
+        return (base + below(std::min(std::max(1, prm.wsPages), numPages))) % numPages;
+
+    case AccessModel::ZIPF:
+        return zipf(numPages, std::max(prm.zipfSkew, 10) / 1000.0) - 1;
+
+    case AccessModel::LOOP: {
+        // Cuerpo [base, base + L) módulo numPages; al agotar las vueltas
+        // el bucle pasa al bloque siguiente
+        int body = std::min(std::max(1, prm.loopPages), numPages);
+        int offset = (page - base + numPages) % numPages + 1;
+        if (offset < body) return (base + offset) % numPages;
+        if (--left <= 0) {
+            base = (base + body) % numPages;
+            left = std::max(1, prm.loopIterations);
+        }
+        return base;
+    }
+
+    case AccessModel::STRIDE:
+        return (page + std::max(1, prm.stride)) % numPages;
+
+    case AccessModel::RANDOM:
+        return below(numPages);
+    }
+    return (page + 1) % numPages;
+}
+
+const char *accessModelName(AccessModel m) {
+    switch (m) {
+        case AccessModel::SEQUENTIAL: return "SEQUENTIAL";
+        case AccessModel::WORKING_SET: return "WORKING_SET";
+        case AccessModel::ZIPF: return "ZIPF";
+        case AccessModel::LOOP: return "LOOP";
+        case AccessModel::STRIDE: return "STRIDE";
+        case AccessModel::RANDOM: return "RANDOM";
+        default: return "UNKNOWN";
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef ACCESS_MODEL_H
+#define ACCESS_MODEL_H
+
+#include <cstdint>
+
+// ========== MODELOS DE REFERENCIAS A MEMORIA ==========
+enum class AccessModel : uint8_t {
+    SEQUENTIAL,     // 0, 1, 2, ... en ronda (comportamiento clásico)
+    WORKING_SET,    // Fases: uniforme dentro de una ventana que salta al azar
+    ZIPF,           // Páginas calientes: P(k) ~ 1 / k^s
+    LOOP,           // Un bucle de loopPages páginas repetido loopIterations veces
+    STRIDE,         // Recorrido con salto fijo (arreglos por columnas)
+    RANDOM          // Uniforme sobre todas las páginas
+};
+
+const int ACCESS_MODEL_COUNT = 6;
+
+// Parámetros comunes a todos los procesos de un planificador
+struct AccessParams {
+    int wsPages;                // WORKING_SET: páginas de la ventana
+    int phaseLength;            // WORKING_SET: accesos por fase
+    int zipfSkew;               // ZIPF: exponente s en milésimas (1000 = s 1.0)
+    int loopPages;              // LOOP: páginas del cuerpo
+    int loopIterations;         // LOOP: vueltas antes de pasar al siguiente bloque
+    int stride;                 // STRIDE: salto entre accesos
+    int writePercent;           // Todos: % de páginas que se escriben (bit M)
+
+    AccessParams();
+};
+
+// ========== FLUJO DE REFERENCIAS DE UN PROCESO ==========
+/**
+ * Estado por PCB del generador de páginas: 24 bytes, sin memoria dinámica.
+ * - splitmix64 como PRNG: una suma y dos multiplicaciones por muestra.
+ * - ZIPF por rechazo-inversión (Hörmann-Derflinger): O(1) esperado y sin
+ *   tablas, así cada proceso puede tener su propia cantidad de páginas.
+ * - SEQUENTIAL no consume números aleatorios: reproduce exactamente la
+ *   ronda 0, 1, 2, ... anterior.
+ */
+struct AccessStream {
+    uint64_t rng;
+    int base;                   // WORKING_SET / LOOP: inicio de la ventana
+    int left;                   // Accesos que quedan en la fase (o vueltas del bucle)
+    AccessModel model;
+
+    AccessStream();
+
+    // Reinicia con la semilla dada; devuelve la primera página
+    int reset(AccessModel m, uint64_t seed, int numPages, const AccessParams &prm);
+    // Página siguiente a 'page' (la que se acaba de acceder)
+    int next(int page, int numPages, const AccessParams &prm);
+
+private:
+    uint64_t nextRandom();
+    int below(int n);                   // Uniforme en [0, n)
+    double unit();                      // Uniforme en (0, 1]
+    int zipf(int n, double s);          // Rango en [1, n]
+    void newPhase(int numPages, const AccessParams &prm);
+};
+
+// Semilla del flujo de un PID (la misma semilla base da los mismos flujos)
+uint64_t accessSeedFor(uint64_t seed, int pid);
+
+// Si el acceso de pid a page es una escritura: cada página se sortea una
+// vez por (pid, página), así un proceso tiene páginas de datos fijas y el
+// flujo de páginas no cambia
+bool accessIsWrite(int pid, int page, const AccessParams &prm);
+
+const char *accessModelName(AccessModel m);
+
+#endif // ACCESS_MODEL_H
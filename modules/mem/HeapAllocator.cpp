@@ -1,7 +1,8 @@
 #include "HeapAllocator.h"
+#include "../snapshot/SnapshotIO.h"
 
 // ========== CONSTRUCTOR ==========
-HeapAllocator::HeapAllocator(size_t heapSize, size_t minSize) 
+HeapAllocator::HeapAllocator(size_t heapSize, size_t minSize, bool verbose) 
     : totalSize(heapSize), minBlockSize(minSize), 
       totalAllocations(0), totalDeallocations(0),
       totalBytesAllocated(0), totalBytesFreed(0),
@@ -18,6 +19,8 @@ HeapAllocator::HeapAllocator(size_t heapSize, size_t minSize)
     Block* initialBlock = new Block(totalSize, 0, maxOrder);
     freeLists[maxOrder].push_back(initialBlock);
     
+    // Silencioso cuando se crean muchas instancias (p. ej. barridos en paralelo)
+    if (!verbose) return;
     std::cout << "HeapAllocator inicializado:\n";
     std::cout << "  Tamaño total: " << totalSize << " bytes\n";
     std::cout << "  Bloque mínimo: " << minBlockSize << " bytes\n";
@@ -355,3 +358,99 @@ void HeapAllocator::reset() {
     Block* initialBlock = new Block(totalSize, 0, maxOrder);
     freeLists[maxOrder].push_back(initialBlock);
 }
+
+// ========== SNAPSHOT ==========
+// Las direcciones son simuladas: los punteros entregados por allocate()
+// siguen siendo válidos tras restaurar
+
+void HeapAllocator::save(SnapshotWriter &w) const {
+    w.put(totalSize);
+    w.put(minBlockSize);
+    w.put(maxOrder);
+    for (const auto &list : freeLists) {
+        w.put<uint64_t>(list.size());
+        for (const Block *b : list) {
+            w.put(b->address);
+            w.put(b->size);
+        }
+    }
+    w.put<uint64_t>(allocatedBlocks.size());
+    for (const auto &e : allocatedBlocks) {
+        w.put(e.second->address);
+        w.put(e.second->size);
+        w.put(e.second->order);
+    }
+    w.put(totalAllocations);
+    w.put(totalDeallocations);
+    w.put(totalBytesAllocated);
+    w.put(totalBytesFreed);
+    w.put(internalFragmentation);
+    w.put(externalFragmentation);
+    w.put(allocTime);
+    w.put(freeTime);
+}
+
+bool HeapAllocator::load(SnapshotReader &r) {
+    size_t total, minSize;
+    int order;
+    if (!r.get(total) || !r.get(minSize) || !r.get(order)) return false;
+    if (order < 0 || order > 62) return r.fail();
+
+    // Se arma aparte y sólo reemplaza al estado actual si todo es válido
+    std::vector<std::vector<Block *>> lists(order + 1);
+    std::map<size_t, Block *> allocated;
+    auto discard = [&]() {
+        for (auto &list : lists)
+            for (Block *b : list) delete b;
+        for (auto &e : allocated) delete e.second;
+        return r.fail();
+    };
+    const size_t entryBytes = 2 * sizeof(size_t);
+    for (int i = 0; i <= order; i++) {
+        uint64_t n;
+        if (!r.getCount(n, entryBytes)) return discard();
+        lists[i].reserve(n);
+        for (uint64_t k = 0; k < n; k++) {
+            size_t addr, size;
+            if (!r.get(addr) || !r.get(size)) return discard();
+            lists[i].push_back(new Block(size, addr, i));
+        }
+    }
+    uint64_t n;
+    if (!r.getCount(n, entryBytes + sizeof(int))) return discard();
+    for (uint64_t k = 0; k < n; k++) {
+        size_t addr, size;
+        int ord;
+        if (!r.get(addr) || !r.get(size) || !r.get(ord)) return discard();
+        if (ord < 0 || ord > order) return discard();
+        Block *b = new Block(size, addr, ord);
+        b->isFree = false;
+        if (!allocated.emplace(addr, b).second) {
+            delete b;
+            return discard();
+        }
+    }
+    size_t counters[6];
+    int times[2];
+    for (size_t &c : counters) r.get(c);
+    for (int &t : times) r.get(t);
+    if (!r.ok()) return discard();
+
+    for (auto &list : freeLists)
+        for (Block *b : list) delete b;
+    for (auto &e : allocatedBlocks) delete e.second;
+    totalSize = total;
+    minBlockSize = minSize;
+    maxOrder = order;
+    freeLists = std::move(lists);
+    allocatedBlocks = std::move(allocated);
+    totalAllocations = counters[0];
+    totalDeallocations = counters[1];
+    totalBytesAllocated = counters[2];
+    totalBytesFreed = counters[3];
+    internalFragmentation = counters[4];
+    externalFragmentation = counters[5];
+    allocTime = times[0];
+    freeTime = times[1];
+    return true;
+}
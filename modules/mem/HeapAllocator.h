@@ -7,6 +7,9 @@
 #include <iostream>
 #include <iomanip>
 
+class SnapshotWriter;
+class SnapshotReader;
+
 // ========== BUDDY SYSTEM ALLOCATOR ==========
 
 /**
@@ -53,7 +56,7 @@ private:
     int freeTime;
     
 public:
-    HeapAllocator(size_t heapSize = 1024 * 1024, size_t minSize = 64);
+    HeapAllocator(size_t heapSize = 1024 * 1024, size_t minSize = 64, bool verbose = true);
     ~HeapAllocator();
     
     // Operaciones principales
@@ -74,6 +77,10 @@ public:
     // Utilidades
     void reset();
     
+    // Snapshot binario: listas libres y bloques asignados por dirección
+    void save(SnapshotWriter &w) const;
+    bool load(SnapshotReader &r);
+    
 private:
     int getOrder(size_t size) const;
     size_t getBlockSize(int order) const;
@@ -1,145 +1,387 @@
 #include "MemoryManager.h"
+#include "../snapshot/SnapshotIO.h"
 #include <iostream>
 #include <iomanip>
 #include <climits>
+#include <algorithm>
 
 // ========== FRAME IMPLEMENTATION ==========
 Frame::Frame() : pid(-1), page(-1) {}
 
 // ========== MEMORY MANAGER IMPLEMENTATION ==========
 MemoryManager::MemoryManager(int nframes, PageAlgo algo)
-    : numFrames(nframes), frames(nframes), totalAccesses(0), totalFaults(0),
-      algorithm(algo), pffThresholdHigh(3), pffThresholdLow(1), pffWindowSize(10) {}
+    : numFrames(nframes), clockHand(0), totalAccesses(0), totalFaults(0), writeBacks(0),
+      algorithm(algo), optPos(0), recordingRefs(false),
+      pffThresholdHigh(3), pffThresholdLow(1), pffWindowSize(10), wsWindow(10) {
+    resetFrames();
+}
+
+// Todos los marcos libres y la tabla dimensionada para numFrames páginas
+void MemoryManager::resetFrames() {
+    frames = std::vector<Frame>(numFrames);
+    pageTable.reset(numFrames);
+    freeMask.assign((numFrames + 63) / 64, 0);
+    freeCount = 0;
+    for (int i = 0; i < numFrames; i++) setFrameFree(i, true);
+    lru.reset(numFrames);
+    frameBits.assign(numFrames, 0);
+    clockHand = 0;
+    loadOrder.reset(numFrames);
+    lfu.reset(numFrames);
+    arc.reset(numFrames);
+    optPos = 0;
+    optNext.assign(numFrames, NO_NEXT_USE);
+    optHeap = {};
+    residents.reset(numFrames);
+    wsTrimmed.reset(numFrames);
+}
+
+int MemoryManager::firstFreeFrame() const {
+    if (freeCount == 0) return -1;
+    for (size_t w = 0; w < freeMask.size(); w++)
+        if (freeMask[w]) return w * 64 + __builtin_ctzll(freeMask[w]);
+    return -1;
+}
+
+void MemoryManager::setFrameFree(int frame, bool isFree) {
+    uint64_t bit = 1ULL << (frame & 63);
+    bool was = freeMask[frame >> 6] & bit;
+    if (was == isFree) return;
+    freeMask[frame >> 6] ^= bit;
+    freeCount += isFree ? 1 : -1;
+}
+
+void MemoryManager::unlinkFrame(int frame) {
+    lru.unlink(frame);
+    loadOrder.unlink(frame);
+    lfu.remove(frame);
+    arc.removeFrame(frame);
+    wsTrimmed.unlink(frame);
+    frameBits[frame] = 0;
+}
+
+// Saca la página del marco de la tabla, de las listas y del conjunto de su dueño
+void MemoryManager::evictFrame(int frame) {
+    ResidentSet &owner = residents.of(frames[frame].pid);
+    residents.unlink(owner, frame);
+    owner.resident--;
+    pageTable.erase(frames[frame].pid, frames[frame].page);
+    unlinkFrame(frame);
+}
+
+ResidentSet &MemoryManager::residentSet(int pid) {
+    ResidentSet &rs = residents.of(pid);
+    // PFF: un proceso nuevo empieza con su parte de la memoria
+    if (rs.allocation == 0) rs.allocation = std::max(1, numFrames / residents.size());
+    return rs;
+}
+
+// Envejecer los contadores LFU cada tantos accesos como 8 vueltas de memoria
+int MemoryManager::lfuAgingPeriod() const {
+    return std::max(64, 8 * numFrames);
+}
 
-bool MemoryManager::access(int pid, int page) {
+bool MemoryManager::access(int pid, int page, bool write) {
     totalAccesses++;
-    auto key = std::make_pair(pid, page);
-    auto it = mapping.find(key);
+    if (algorithm == PageAlgo::LFU && totalAccesses % lfuAgingPeriod() == 0) lfu.age();
+    if (recordingRefs) recordedRefs.push_back({pid, page, write});
+    int nextUse = algorithm == PageAlgo::OPT ? optAdvance(pid, page) : NO_NEXT_USE;
+    uint8_t bits = REF_BIT | (write ? DIRTY_BIT : 0);
+    ResidentSet &rs = residentSet(pid);
+    rs.virtualTime++;
 
     // HIT: página ya está en memoria
-    if (it != mapping.end()) {
-        lastUse[key] = totalAccesses;
+    if (PageTable::Entry *e = pageTable.find(pid, page)) {
+        int f = e->frame;
+        e->lastUse = totalAccesses;
+        if (f != lru.tail()) {
+            lru.unlink(f);
+            lru.pushBack(f);
+        }
+        frameBits[f] |= bits;
+        if (algorithm == PageAlgo::LFU) lfu.touch(f);
+        else if (algorithm == PageAlgo::ARC) arc.hit(f);
+        else if (algorithm == PageAlgo::OPT) optSetNext(f, nextUse);
+        // WS: una página recortada vuelve al working set
+        if (wsTrimmed.contains(f)) {
+            wsTrimmed.unlink(f);
+            residents.link(rs, f);
+        } else {
+            residents.touch(rs, f);
+        }
+        finishAccess(rs, false);
         return false;
     }
 
     // MISS: fallo de página
     totalFaults++;
-    pidFaultCount[pid]++;
-    
-    // Buscar marco libre
-    int freeIdx = -1;
-    for (int i = 0; i < numFrames; i++) {
-        if (frames[i].pid == -1) {
-            freeIdx = i;
-            break;
-        }
-    }
 
-    if (freeIdx != -1) {
-        // Asignar a marco libre
-        frames[freeIdx].pid = pid;
-        frames[freeIdx].page = page;
-        mapping[key] = freeIdx;
-        fifoQueue.push(freeIdx);
-        lastUse[key] = totalAccesses;
-        pidFrameCount[pid]++;
+    // Marco libre de menor índice; si no hay, víctima según algoritmo.
+    // ARC adapta sus listas en todo fallo y, con memoria llena, ya elige
+    int target = firstFreeFrame();
+    int arcVictim = algorithm == PageAlgo::ARC ? arc.fault(pid, page, target == -1, frames) : -1;
+    if (target != -1) {
+        setFrameFree(target, false);
     } else {
-        // Seleccionar víctima según algoritmo
-        int victim = -1;
         switch (algorithm) {
             case PageAlgo::FIFO:
-                victim = selectVictimFIFO();
+                target = selectVictimFIFO();
                 break;
             case PageAlgo::LRU:
-                victim = selectVictimLRU();
+                target = selectVictimLRU();
                 break;
             case PageAlgo::PFF:
-                victim = selectVictimPFF(pid);
+                target = selectVictimPFF(rs);
+                break;
+            case PageAlgo::CLOCK:
+                target = selectVictimClock();
+                break;
+            case PageAlgo::SECOND_CHANCE:
+                target = selectVictimSecondChance();
+                break;
+            case PageAlgo::ENHANCED_CLOCK:
+                target = selectVictimEnhancedClock();
+                break;
+            case PageAlgo::LFU:
+                target = lfu.victim();
+                break;
+            case PageAlgo::ARC:
+                target = arcVictim;
+                break;
+            case PageAlgo::OPT:
+                target = selectVictimOPT();
+                break;
+            case PageAlgo::WS:
+                target = selectVictimWS();
                 break;
         }
-
-        // Reemplazar víctima
-        auto victimKey = std::make_pair(frames[victim].pid, frames[victim].page);
-        mapping.erase(victimKey);
-        lastUse.erase(victimKey);
-        pidFrameCount[frames[victim].pid]--;
-        
-        frames[victim].pid = pid;
-        frames[victim].page = page;
-        mapping[key] = victim;
-        lastUse[key] = totalAccesses;
-        fifoQueue.push(victim);
-        pidFrameCount[pid]++;
+        if (frameBits[target] & DIRTY_BIT) writeBacks++;
+        evictFrame(target);
     }
+
+    frames[target].pid = pid;
+    frames[target].page = page;
+    pageTable.insert(pid, page, target, totalAccesses);
+    lru.pushBack(target);
+    residents.link(rs, target);
+    rs.resident++;
+    frameBits[target] = bits;
+    if (algorithm == PageAlgo::FIFO || algorithm == PageAlgo::SECOND_CHANCE) loadOrder.pushBack(target);
+    else if (algorithm == PageAlgo::LFU) lfu.insert(target);
+    else if (algorithm == PageAlgo::ARC) arc.place(target);
+    else if (algorithm == PageAlgo::OPT) optSetNext(target, nextUse);
+    finishAccess(rs, true);
     return true;
 }
 
+// Ventana de fallos, estadísticas y ajustes de PFF/WS después de cada acceso
+void MemoryManager::finishAccess(ResidentSet &rs, bool fault) {
+    uint64_t leaving = (rs.faultHistory >> (pffWindowSize - 1)) & 1;
+    rs.faultHistory = ((rs.faultHistory << 1) | fault) & pffWindowMask();
+    rs.windowFaults += (int)fault - (int)leaving;
+    rs.faults += fault;
+    rs.peakResident = std::max(rs.peakResident, rs.resident);
+    rs.residentSum += rs.resident;
+
+    if (algorithm == PageAlgo::PFF && rs.virtualTime % pffWindowSize == 0) {
+        // Una vez por ventana: muchos fallos agrandan la asignación, pocos
+        // la achican y se libera la página menos reciente que sobra
+        if (rs.windowFaults > pffThresholdHigh) {
+            rs.allocation = std::min(numFrames, rs.allocation + 1);
+        } else if (rs.windowFaults < pffThresholdLow && rs.allocation > 1) {
+            rs.allocation--;
+            if (rs.resident > rs.allocation && rs.head != -1) {
+                int f = rs.head;
+                if (frameBits[f] & DIRTY_BIT) writeBacks++;
+                evictFrame(f);
+                frames[f] = Frame();
+                setFrameFree(f, true);
+            }
+        }
+    } else if (algorithm == PageAlgo::WS) {
+        // Las páginas sin uso en los últimos τ accesos del proceso salen
+        // del working set: quedan residentes pero son las primeras víctimas
+        while (rs.head != -1 && residents.useOf(rs.head) <= rs.virtualTime - wsWindow) {
+            int f = rs.head;
+            residents.unlink(rs, f);
+            wsTrimmed.pushBack(f);
+        }
+    }
+}
+
+uint64_t MemoryManager::pffWindowMask() const {
+    return pffWindowSize >= 64 ? ~0ULL : (1ULL << pffWindowSize) - 1;
+}
+
 int MemoryManager::selectVictimFIFO() {
-    int victim = fifoQueue.front();
-    fifoQueue.pop();
-    return victim;
+    // La cabeza del orden de carga es la página cargada hace más tiempo
+    return loadOrder.head();
 }
 
 int MemoryManager::selectVictimLRU() {
-    int oldest = INT_MAX;
-    int victim = -1;
-    for (auto &kv : mapping) {
-        if (lastUse[kv.first] < oldest) {
-            oldest = lastUse[kv.first];
-            victim = kv.second;
-        }
+    // La cabeza de la lista es el marco con el último uso más antiguo
+    return lru.head();
+}
+
+int MemoryManager::selectVictimPFF(const ResidentSet &rs) {
+    // Por debajo de su asignación el proceso crece a costa del que más se
+    // pasa de la suya (a igual exceso, el de menor PID); si no, reemplazo
+    // local de su página menos reciente
+    if (rs.resident < rs.allocation) {
+        const ResidentSet *donor = nullptr;
+        residents.forEach([&](const ResidentSet &o) {
+            int excess = o.resident - o.allocation;
+            if (excess <= 0 || o.head == -1) return;
+            int best = donor ? donor->resident - donor->allocation : 0;
+            if (excess > best || (excess == best && o.pid < donor->pid)) donor = &o;
+        });
+        if (donor) return donor->head;
     }
+    if (rs.head != -1) return rs.head;
+    return selectVictimLRU();
+}
+
+int MemoryManager::selectVictimWS() {
+    // Primero lo que quedó fuera de todo working set, lo recortado antes;
+    // si los working sets llenan la memoria, LRU global (Denning
+    // suspendería un proceso)
+    if (wsTrimmed.head() != -1) return wsTrimmed.head();
+    return selectVictimLRU();
+}
+
+// Las víctimas se eligen sólo con memoria llena: todo marco tiene página
+
+int MemoryManager::selectVictimClock() {
+    // La manecilla apaga bits de referencia hasta dar con uno apagado
+    while (frameBits[clockHand] & REF_BIT) {
+        frameBits[clockHand] &= ~REF_BIT;
+        clockHand = (clockHand + 1) % numFrames;
+    }
+    int victim = clockHand;
+    clockHand = (clockHand + 1) % numFrames;
     return victim;
 }
 
-int MemoryManager::selectVictimPFF(int pid) {
-    // PFF: Si el proceso tiene alta frecuencia de fallos, le damos más frames
-    // Si tiene baja frecuencia, le quitamos frames
-    int faultFreq = pidFaultCount[pid];
-    
-    if (faultFreq > pffThresholdHigh) {
-        // Alta frecuencia: buscar víctima de otro proceso
-        for (auto &kv : mapping) {
-            int victimPid = frames[kv.second].pid;
-            if (victimPid != pid && pidFaultCount[victimPid] < pffThresholdLow) {
-                return kv.second;
-            }
+int MemoryManager::selectVictimSecondChance() {
+    // Una página referenciada pierde el bit y vuelve al final de la cola
+    int victim = loadOrder.head();
+    while (frameBits[victim] & REF_BIT) {
+        frameBits[victim] &= ~REF_BIT;
+        loadOrder.unlink(victim);
+        loadOrder.pushBack(victim);
+        victim = loadOrder.head();
+    }
+    return victim;
+}
+
+int MemoryManager::selectVictimEnhancedClock() {
+    // Clases (R, M): sale la primera (0, 0). Una (1, x) pierde R; una
+    // (0, 1) se escribe a disco al pasar y queda limpia para la próxima
+    // vuelta, así las páginas limpias salen antes que las modificadas
+    while (frameBits[clockHand] != 0) {
+        if (frameBits[clockHand] & REF_BIT) {
+            frameBits[clockHand] &= ~REF_BIT;
+        } else {
+            frameBits[clockHand] &= ~DIRTY_BIT;
+            writeBacks++;
         }
+        clockHand = (clockHand + 1) % numFrames;
+    }
+    int victim = clockHand;
+    clockHand = (clockHand + 1) % numFrames;
+    return victim;
+}
+
+int MemoryManager::optAdvance(int pid, int page) {
+    if (optPos < 0) return NO_NEXT_USE;
+    if (optPos >= (int)optRefs.size() || optRefs[optPos].pid != pid || optRefs[optPos].page != page) {
+        optPos = -1;
+        return NO_NEXT_USE;
+    }
+    return optNextUse[optPos++];
+}
+
+void MemoryManager::optSetNext(int frame, int next) {
+    optNext[frame] = next;
+    if (optPos < 0) return;
+    optHeap.push({next, frame});
+    // Las entradas viejas se acumulan con los aciertos: con más del doble
+    // de los marcos se rehace el heap sólo con los ocupados (O(1) amortizado)
+    if (optHeap.size() > 2 * (size_t)numFrames + 64) {
+        std::vector<std::pair<int, int>> live;
+        for (int f = 0; f < numFrames; f++)
+            if (frames[f].pid != -1) live.push_back({optNext[f], f});
+        optHeap = std::priority_queue<std::pair<int, int>>(std::less<std::pair<int, int>>(), std::move(live));
+    }
+}
+
+int MemoryManager::selectVictimOPT() {
+    // La página usada más tarde (o nunca más); una entrada es vieja si el
+    // marco ya tiene otro próximo uso o quedó libre
+    while (optPos >= 0 && !optHeap.empty()) {
+        std::pair<int, int> top = optHeap.top();
+        optHeap.pop();
+        if (frames[top.second].pid != -1 && optNext[top.second] == top.first) return top.second;
     }
-    
-    // Fallback a LRU si no se aplica PFF
     return selectVictimLRU();
 }
 
 void MemoryManager::freeFramesOfPid(int pid) {
     for (int i = 0; i < numFrames; i++) {
         if (frames[i].pid == pid) {
-            auto key = std::make_pair(frames[i].pid, frames[i].page);
-            mapping.erase(key);
-            lastUse.erase(key);
+            evictFrame(i);
             frames[i].pid = -1;
             frames[i].page = -1;
+            setFrameFree(i, true);
         }
     }
-    pidFrameCount.erase(pid);
-    pidFaultCount.erase(pid);
+    arc.forgetPid(pid);
+    residents.erase(pid);
+}
+
+void MemoryManager::setPFFParams(int high, int low, int window) {
+    pffThresholdHigh = std::max(0, high);
+    pffThresholdLow = std::max(0, low);
+    pffWindowSize = std::min(std::max(1, window), 64);
+    // El historial de cada proceso se recorta a la ventana nueva
+    residents.forEach([this](ResidentSet &rs) {
+        rs.faultHistory &= pffWindowMask();
+        rs.windowFaults = __builtin_popcountll(rs.faultHistory);
+    });
 }
 
+void MemoryManager::setWorkingSetWindow(int tau) { wsWindow = std::max(1, tau); }
+
+int MemoryManager::getWorkingSetWindow() const { return wsWindow; }
+
+const ResidentSet *MemoryManager::getResidentSet(int pid) const { return residents.find(pid); }
+
 void MemoryManager::setNumFrames(int nframes) {
     numFrames = nframes;
-    frames = std::vector<Frame>(nframes);
-    mapping.clear();
-    fifoQueue = {};
-    lastUse.clear();
+    resetFrames();
 }
 
 void MemoryManager::setAlgorithm(PageAlgo algo) {
+    // Se vacían también los marcos: sin la estructura del algoritmo no habría víctima
     algorithm = algo;
-    mapping.clear();
-    fifoQueue = {};
-    lastUse.clear();
+    resetFrames();
 }
 
+void MemoryManager::setOptimalReferences(const std::vector<PageRef> &refs) {
+    optRefs = refs;
+    optNextUse = computeNextUse(refs);
+    setAlgorithm(PageAlgo::OPT);
+}
+
+void MemoryManager::recordReferences(bool on) {
+    recordingRefs = on;
+    if (on) recordedRefs.clear();
+}
+
+bool MemoryManager::isRecordingReferences() const { return recordingRefs; }
+
+const std::vector<PageRef> &MemoryManager::getRecordedReferences() const { return recordedRefs; }
+
 void MemoryManager::showFrames() const {
     std::cout << "\n╔════════════════════════════════════════════════════╗\n";
     std::cout << "║         MEMORIA VIRTUAL - " << std::left << std::setw(23) << getAlgorithmName() << "   ║\n";
@@ -167,6 +409,45 @@ void MemoryManager::showFrames() const {
     std::cout << "  Fallos de página: " << totalFaults << "\n";
     std::cout << "  Hit Rate: " << std::fixed << std::setprecision(2) 
               << getHitRate() << "%\n";
+    std::cout << "  Escrituras a disco: " << writeBacks << "\n";
+    if (algorithm == PageAlgo::ARC) {
+        std::cout << "  ARC: T1=" << arc.sizeT1() << " T2=" << arc.sizeT2()
+                  << " objetivo p=" << arc.getTarget()
+                  << " fantasmas=" << arc.ghostCount() << "\n";
+    }
+    showResidentSets();
+}
+
+void MemoryManager::showResidentSets() const {
+    std::vector<const ResidentSet *> sets = residents.sorted();
+    if (sets.empty()) return;
+    std::ios::fmtflags saved = std::cout.flags();
+    if (algorithm == PageAlgo::PFF)
+        std::cout << "\nPFF: ventana " << pffWindowSize << " accesos, crecer con > "
+                  << pffThresholdHigh << " fallos, achicar con < " << pffThresholdLow << "\n";
+    else if (algorithm == PageAlgo::WS)
+        std::cout << "\nWS: ventana τ = " << wsWindow << " accesos del proceso\n";
+    std::cout << "\n┌───────┬─────────┬────────┬──────────┬─────────┬──────────┬─────────┬────────┬───────┐\n";
+    std::cout << "│  PID  │ Marcos  │   WS   │ Asignado │ Fallos  │ Accesos  │ Ventana │ Prom.  │ Pico  │\n";
+    std::cout << "├───────┼─────────┼────────┼──────────┼─────────┼──────────┼─────────┼────────┼───────┤\n";
+    for (const ResidentSet *rs : sets) {
+        std::cout << "│ " << std::right << std::setw(5) << rs->pid
+                  << " │ " << std::setw(7) << rs->resident
+                  << " │ " << std::setw(6) << rs->listed
+                  << " │ " << std::setw(8);
+        if (algorithm == PageAlgo::PFF) std::cout << rs->allocation;
+        else std::cout << "-";
+        std::cout << " │ " << std::setw(7) << rs->faults
+                  << " │ " << std::setw(8) << rs->virtualTime
+                  << " │ " << std::setw(7) << rs->windowFaults
+                  << " │ " << std::setw(6) << std::fixed << std::setprecision(2)
+                  << (rs->virtualTime > 0 ? (double)rs->residentSum / rs->virtualTime : 0.0)
+                  << " │ " << std::setw(5) << rs->peakResident << " │\n";
+    }
+    std::cout << "└───────┴─────────┴────────┴──────────┴─────────┴──────────┴─────────┴────────┴───────┘\n";
+    std::cout << "WS = páginas usadas dentro de la ventana; Ventana = fallos en los últimos "
+              << pffWindowSize << " accesos\n";
+    std::cout.flags(saved);
 }
 
 double MemoryManager::getHitRate() const {
@@ -177,12 +458,188 @@ double MemoryManager::getHitRate() const {
 
 int MemoryManager::getTotalFaults() const { return totalFaults; }
 int MemoryManager::getTotalAccesses() const { return totalAccesses; }
+int MemoryManager::getNumFrames() const { return numFrames; }
+int MemoryManager::getWriteBacks() const { return writeBacks; }
+PageAlgo MemoryManager::getAlgorithm() const { return algorithm; }
+
+std::string MemoryManager::getAlgorithmName() const { return pageAlgoName(algorithm); }
 
-std::string MemoryManager::getAlgorithmName() const {
-    switch (algorithm) {
+const char *pageAlgoName(PageAlgo algo) {
+    switch (algo) {
         case PageAlgo::FIFO: return "FIFO";
         case PageAlgo::LRU: return "LRU";
         case PageAlgo::PFF: return "PFF (Advanced)";
+        case PageAlgo::CLOCK: return "CLOCK";
+        case PageAlgo::SECOND_CHANCE: return "Second Chance";
+        case PageAlgo::ENHANCED_CLOCK: return "Enhanced CLOCK";
+        case PageAlgo::LFU: return "LFU (Aging)";
+        case PageAlgo::ARC: return "ARC";
+        case PageAlgo::OPT: return "OPT (Belady)";
+        case PageAlgo::WS: return "WS (Denning)";
         default: return "UNKNOWN";
     }
 }
+
+// ========== SNAPSHOT ==========
+
+// Tabla de páginas ordenada por (pid, página): una lista de marcos y otra
+// de últimos usos, así el archivo no depende del orden del hash
+static void savePageTable(SnapshotWriter &w, const PageTable &table) {
+    std::vector<PageTable::Entry> entries;
+    table.forEach([&entries](const PageTable::Entry &e) { entries.push_back(e); });
+    std::sort(entries.begin(), entries.end(),
+              [](const PageTable::Entry &a, const PageTable::Entry &b) { return a.key < b.key; });
+    for (int field = 0; field < 2; field++) {
+        w.put<uint64_t>(entries.size());
+        for (const auto &e : entries) {
+            w.put(PageTable::pidOf(e));
+            w.put(PageTable::pageOf(e));
+            w.put(field == 0 ? e.frame : e.lastUse);
+        }
+    }
+}
+
+static bool loadPageTable(SnapshotReader &r, PageTable &table, const std::vector<Frame> &frames) {
+    uint64_t n;
+    if (!r.getCount(n, 3 * sizeof(int))) return false;
+    for (uint64_t i = 0; i < n; i++) {
+        int pid, page, frame;
+        if (!r.get(pid) || !r.get(page) || !r.get(frame)) return false;
+        if (frame < 0 || frame >= (int)frames.size() || frames[frame].pid != pid ||
+            frames[frame].page != page || table.find(pid, page))
+            return r.fail();
+        table.insert(pid, page, frame, 0);
+    }
+    if (!r.getCount(n, 3 * sizeof(int))) return false;
+    if ((int)n != table.size()) return r.fail();
+    for (uint64_t i = 0; i < n; i++) {
+        int pid, page, use;
+        if (!r.get(pid) || !r.get(page) || !r.get(use)) return false;
+        PageTable::Entry *e = table.find(pid, page);
+        if (!e) return r.fail();
+        e->lastUse = use;
+    }
+    return true;
+}
+
+void MemoryManager::save(SnapshotWriter &w) const {
+    w.put(numFrames);
+    w.put(algorithm);
+    w.put(totalAccesses);
+    w.put(totalFaults);
+    w.put(pffThresholdHigh);
+    w.put(pffThresholdLow);
+    w.put(pffWindowSize);
+    w.putVector(frames);
+    savePageTable(w, pageTable);
+    w.put(wsWindow);
+    residents.save(w);
+    std::vector<int> trimmed;
+    for (int f = wsTrimmed.head(); f != -1; f = wsTrimmed.after(f)) trimmed.push_back(f);
+    w.putVector(trimmed);
+    w.put(writeBacks);
+    w.put(clockHand);
+    w.putVector(frameBits);
+    // Sólo el algoritmo activo mantiene su estructura
+    if (algorithm == PageAlgo::FIFO || algorithm == PageAlgo::SECOND_CHANCE) {
+        std::vector<int> loaded;
+        for (int f = loadOrder.head(); f != -1; f = loadOrder.after(f)) loaded.push_back(f);
+        w.putVector(loaded);
+    } else if (algorithm == PageAlgo::LFU) {
+        lfu.save(w);
+    } else if (algorithm == PageAlgo::ARC) {
+        arc.save(w);
+    } else if (algorithm == PageAlgo::OPT) {
+        std::vector<int> pids, pages;
+        std::vector<uint8_t> writes;
+        for (const PageRef &ref : optRefs) {
+            pids.push_back(ref.pid);
+            pages.push_back(ref.page);
+            writes.push_back(ref.write);
+        }
+        w.putVector(pids);
+        w.putVector(pages);
+        w.putVector(writes);
+        w.put(optPos);
+        w.putVector(optNext);
+    }
+}
+
+bool MemoryManager::load(SnapshotReader &r) {
+    MemoryManager next(0, algorithm);
+    if (!r.get(next.numFrames) || !r.get(next.algorithm) || !r.get(next.totalAccesses) ||
+        !r.get(next.totalFaults) || !r.get(next.pffThresholdHigh) ||
+        !r.get(next.pffThresholdLow) || !r.get(next.pffWindowSize) ||
+        !r.getVector(next.frames)) return false;
+    if (next.numFrames < 0 || (int)next.frames.size() != next.numFrames ||
+        (int)next.algorithm < 0 || (int)next.algorithm >= PAGE_ALGO_COUNT) return r.fail();
+    next.pageTable.reset(next.numFrames);
+    if (next.pffWindowSize < 1 || next.pffWindowSize > 64) return r.fail();
+    std::vector<int> trimmed;
+    if (!loadPageTable(r, next.pageTable, next.frames) || !r.get(next.wsWindow) ||
+        !next.residents.load(r, next.frames) || !r.getVector(trimmed)) return false;
+    // Todo marco ocupado está en la lista de su proceso o recortado por WS
+    int listed = 0;
+    next.residents.forEach([&listed](const ResidentSet &rs) { listed += rs.listed; });
+    if (next.wsWindow < 1 || listed + (int)trimmed.size() != next.pageTable.size()) return r.fail();
+    next.wsTrimmed.reset(next.numFrames);
+    for (int f : trimmed) {
+        if (f < 0 || f >= next.numFrames || next.frames[f].pid == -1 || next.residents.contains(f) ||
+            next.wsTrimmed.contains(f)) return r.fail();
+        next.wsTrimmed.pushBack(f);
+    }
+    // Un marco ocupado debe figurar en la tabla; los demás quedan libres
+    next.freeMask.assign((next.numFrames + 63) / 64, 0);
+    next.freeCount = 0;
+    for (int i = 0; i < next.numFrames; i++) {
+        if (next.frames[i].pid == -1) next.setFrameFree(i, true);
+        else if (!next.pageTable.find(next.frames[i].pid, next.frames[i].page)) return r.fail();
+    }
+    // La lista de recencia se rearma ordenando los ocupados por último uso
+    std::vector<std::pair<int, int>> byUse;
+    next.pageTable.forEach([&byUse](const PageTable::Entry &e) { byUse.push_back({e.lastUse, e.frame}); });
+    std::sort(byUse.begin(), byUse.end());
+    next.lru.reset(next.numFrames);
+    for (const auto &u : byUse) next.lru.pushBack(u.second);
+
+    next.loadOrder.reset(next.numFrames);
+    next.lfu.reset(next.numFrames);
+    next.arc.reset(next.numFrames);
+    if (!r.get(next.writeBacks) || !r.get(next.clockHand) || !r.getVector(next.frameBits))
+        return false;
+    if ((int)next.frameBits.size() != next.numFrames || next.clockHand < 0 ||
+        (next.clockHand >= next.numFrames && next.clockHand != 0)) return r.fail();
+    if (next.algorithm == PageAlgo::FIFO || next.algorithm == PageAlgo::SECOND_CHANCE) {
+        std::vector<int> loaded;
+        if (!r.getVector(loaded)) return false;
+        if ((int)loaded.size() != next.pageTable.size()) return r.fail();
+        for (int f : loaded) {
+            if (f < 0 || f >= next.numFrames || next.frames[f].pid == -1 ||
+                next.loadOrder.contains(f)) return r.fail();
+            next.loadOrder.pushBack(f);
+        }
+    } else if (next.algorithm == PageAlgo::LFU) {
+        if (!next.lfu.load(r, next.frames)) return false;
+    } else if (next.algorithm == PageAlgo::ARC) {
+        if (!next.arc.load(r, next.frames)) return false;
+    } else if (next.algorithm == PageAlgo::OPT) {
+        std::vector<int> pids, pages;
+        std::vector<uint8_t> writes;
+        if (!r.getVector(pids) || !r.getVector(pages) || !r.getVector(writes) ||
+            !r.get(next.optPos) || !r.getVector(next.optNext)) return false;
+        if (pages.size() != pids.size() || writes.size() != pids.size() || next.optPos < -1 ||
+            next.optPos > (int)pids.size() || (int)next.optNext.size() != next.numFrames)
+            return r.fail();
+        for (size_t i = 0; i < pids.size(); i++) next.optRefs.push_back({pids[i], pages[i], writes[i] != 0});
+        next.optNextUse = computeNextUse(next.optRefs);
+        std::vector<std::pair<int, int>> live;
+        for (int f = 0; f < next.numFrames; f++)
+            if (next.frames[f].pid != -1) live.push_back({next.optNext[f], f});
+        next.optHeap = std::priority_queue<std::pair<int, int>>(std::less<std::pair<int, int>>(), std::move(live));
+    }
+    // La grabación de referencias no es parte del estado simulado
+    next.recordingRefs = recordingRefs;
+    next.recordedRefs = std::move(recordedRefs);
+    *this = std::move(next);
+    return true;
+}
@@ -2,18 +2,34 @@
 #define MEMORY_MANAGER_H
 
 #include <vector>
-#include <map>
 #include <queue>
-#include <utility>
+#include <cstdint>
 #include <string>
+#include "PageTable.h"
+#include "PageReplacement.h"
+#include "ReferenceString.h"
+
+class SnapshotWriter;
+class SnapshotReader;
 
 // ========== ALGORITMOS DE REEMPLAZO ==========
 enum class PageAlgo { 
     FIFO,   // First In First Out
     LRU,    // Least Recently Used
-    PFF     // Page Fault Frequency (avanzado)
+    PFF,    // Page Fault Frequency (avanzado)
+    CLOCK,          // Reloj con bit de referencia
+    SECOND_CHANCE,  // Cola FIFO con bit de referencia
+    ENHANCED_CLOCK, // Reloj con bits de referencia y modificado
+    LFU,            // Least Frequently Used con envejecimiento
+    ARC,            // Adaptive Replacement Cache
+    OPT,            // Óptimo de Belady (fuera de línea, con la cadena completa)
+    WS              // Working set de Denning con ventana τ
 };
 
+const int PAGE_ALGO_COUNT = 10;
+
+const char *pageAlgoName(PageAlgo algo);
+
 const int DEFAULT_NUM_FRAMES = 4;
 
 // ========== FRAME (MARCO) ==========
@@ -26,46 +42,120 @@ struct Frame {
 // ========== MEMORY MANAGER ==========
 /**
  * Gestor de memoria virtual con paginación.
- * Soporta algoritmos FIFO, LRU y PFF (Page Fault Frequency).
+ * Soporta FIFO, LRU, PFF (Page Fault Frequency), CLOCK, segunda
+ * oportunidad, CLOCK mejorado, LFU con envejecimiento, ARC y working set.
+ * LRU en O(1): los aciertos mueven el marco al final de la lista de
+ * recencia y la víctima es su cabeza. Los demás eligen víctima en O(1)
+ * amortizado: cada paso extra de las manecillas apaga un bit que encendió
+ * un acceso.
+ * OPT conoce de antemano la cadena de referencias (setOptimalReferences):
+ * los próximos usos salen de una pasada hacia atrás y la víctima, de un
+ * heap máximo por próximo uso en O(log marcos). Si los accesos se apartan
+ * de la cadena, sigue como LRU.
+ * Cada proceso tiene su conjunto residente (lista de recencia propia y
+ * estadísticas). PFF mide sus fallos en una ventana deslizante de
+ * pffWindowSize accesos y ajusta su asignación una vez por ventana; WS
+ * recorta las páginas sin uso en los últimos τ accesos del proceso y las
+ * deja como primeras víctimas. Ambos en O(1) por acceso.
  */
 class MemoryManager {
 private:
     int numFrames;
     std::vector<Frame> frames;
-    std::queue<int> fifoQueue;
-    std::map<std::pair<int, int>, int> mapping;      // (pid, page) -> frameIndex
-    std::map<std::pair<int, int>, int> lastUse;      // for LRU
+    PageTable pageTable;                // (pid, page) -> marco y último uso
+    std::vector<uint64_t> freeMask;     // Bit i = marco i libre
+    int freeCount;
+    // Recencia: marcos ocupados del menos usado (cabeza) al más reciente
+    FrameList lru;
+    std::vector<uint8_t> frameBits;     // REF_BIT | DIRTY_BIT por marco
+    int clockHand;                      // CLOCK y CLOCK mejorado
+    FrameList loadOrder;                // FIFO y segunda oportunidad: orden de carga
+    LfuList lfu;
+    ArcLists arc;
     int totalAccesses;
     int totalFaults;
+    int writeBacks;                     // Páginas modificadas escritas a disco
     PageAlgo algorithm;
 
-    // PFF (Page Fault Frequency) - parámetros avanzados
+    // OPT: cadena conocida, próximo uso de cada posición y de cada marco;
+    // el heap tiene entradas viejas que se descartan al salir
+    std::vector<PageRef> optRefs;
+    std::vector<int> optNextUse;
+    int optPos;                         // Próxima referencia esperada (-1 = se apartó)
+    std::vector<int> optNext;
+    std::priority_queue<std::pair<int, int>> optHeap;   // (próximo uso, marco)
+
+    // Grabación de la cadena de referencias (para comparar contra OPT)
+    bool recordingRefs;
+    std::vector<PageRef> recordedRefs;
+
+    static const uint8_t REF_BIT = 1;
+    static const uint8_t DIRTY_BIT = 2;
+
+    // PFF (Page Fault Frequency): fallos por ventana para crecer/achicar
     int pffThresholdHigh;
     int pffThresholdLow;
-    int pffWindowSize;
-    std::map<int, int> pidFrameCount;
-    std::map<int, int> pidFaultCount;
+    int pffWindowSize;                  // Accesos del proceso (1..64)
+    int wsWindow;                       // τ de WS, en accesos del proceso
+    ResidentSets residents;
+    FrameList wsTrimmed;                // WS: residentes fuera de todo working set
 
 public:
     MemoryManager(int nframes = DEFAULT_NUM_FRAMES, PageAlgo algo = PageAlgo::FIFO);
     
     // Operaciones principales
-    bool access(int pid, int page);
+    bool access(int pid, int page, bool write = false);
     void freeFramesOfPid(int pid);
     void setNumFrames(int nframes);
     void setAlgorithm(PageAlgo algo);
+    // PFF: umbrales de fallos por ventana y tamaño de la ventana (<= 64)
+    void setPFFParams(int high, int low, int window);
+    void setWorkingSetWindow(int tau);
+    // Pasa a OPT con la cadena que van a seguir los próximos accesos
+    void setOptimalReferences(const std::vector<PageRef> &refs);
+
+    // Graba cada acceso; empezar descarta la grabación anterior
+    void recordReferences(bool on);
+    bool isRecordingReferences() const;
+    const std::vector<PageRef> &getRecordedReferences() const;
     
     // Estadísticas y visualización
     void showFrames() const;
     double getHitRate() const;
     int getTotalFaults() const;
     int getTotalAccesses() const;
+    int getNumFrames() const;
+    int getWriteBacks() const;
+    int getWorkingSetWindow() const;
+    const ResidentSet *getResidentSet(int pid) const;   // nullptr si nunca accedió
+    void showResidentSets() const;
+    PageAlgo getAlgorithm() const;
     std::string getAlgorithmName() const;
     
+    // Snapshot binario (marcos, tabla de mapeo, estado de cada algoritmo)
+    void save(SnapshotWriter &w) const;
+    bool load(SnapshotReader &r);
+    
 private:
+    void resetFrames();
+    int firstFreeFrame() const;         // Marco libre de menor índice (-1 = ninguno)
+    void setFrameFree(int frame, bool isFree);
+    void unlinkFrame(int frame);        // Saca el marco de todas las listas
+    void evictFrame(int frame);
+    ResidentSet &residentSet(int pid);
+    void finishAccess(ResidentSet &rs, bool fault);
+    uint64_t pffWindowMask() const;
+    int lfuAgingPeriod() const;
     int selectVictimFIFO();
     int selectVictimLRU();
-    int selectVictimPFF(int pid);
+    int selectVictimPFF(const ResidentSet &rs);
+    int selectVictimWS();
+    int selectVictimClock();
+    int selectVictimSecondChance();
+    int selectVictimEnhancedClock();
+    int optAdvance(int pid, int page);  // Próximo uso de esta referencia
+    void optSetNext(int frame, int next);
+    int selectVictimOPT();
 };
 
 #endif // MEMORY_MANAGER_H
@@ -0,0 +1,452 @@
+#include "PageReplacement.h"
+#include "MemoryManager.h"
+#include "../snapshot/SnapshotIO.h"
+#include <algorithm>
+#include <map>
+
+// Marcos ocupados: las listas de un snapshot deben cubrirlos exactamente
+static int occupiedFrames(const std::vector<Frame> &frames) {
+    int n = 0;
+    for (const Frame &fr : frames)
+        if (fr.pid != -1) n++;
+    return n;
+}
+
+// ========== LISTA DE MARCOS ==========
+
+FrameList::FrameList() : first(-1), last(-1) {}
+
+void FrameList::reset(int frames) {
+    prev.assign(frames, -1);
+    next.assign(frames, -1);
+    linked.assign(frames, 0);
+    first = last = -1;
+}
+
+void FrameList::pushBack(int f) {
+    prev[f] = last;
+    next[f] = -1;
+    if (last == -1) first = f;
+    else next[last] = f;
+    last = f;
+    linked[f] = 1;
+}
+
+void FrameList::unlink(int f) {
+    if (!linked[f]) return;
+    if (prev[f] == -1) first = next[f];
+    else next[prev[f]] = next[f];
+    if (next[f] == -1) last = prev[f];
+    else prev[next[f]] = prev[f];
+    prev[f] = next[f] = -1;
+    linked[f] = 0;
+}
+
+// ========== LFU CON ENVEJECIMIENTO ==========
+
+LfuList::LfuList() { reset(0); }
+
+void LfuList::reset(int frames) {
+    prev.assign(frames, -1);
+    next.assign(frames, -1);
+    count.assign(frames, -1);
+    head = tail = -1;
+    std::fill(lastOf, lastOf + MAX_COUNT + 1, -1);
+}
+
+void LfuList::unlink(int f) {
+    if (prev[f] == -1) head = next[f];
+    else next[prev[f]] = next[f];
+    if (next[f] == -1) tail = prev[f];
+    else prev[next[f]] = prev[f];
+    prev[f] = next[f] = -1;
+}
+
+void LfuList::insertAfter(int f, int anchor) {
+    int after = anchor == -1 ? head : next[anchor];
+    prev[f] = anchor;
+    next[f] = after;
+    if (anchor == -1) head = f;
+    else next[anchor] = f;
+    if (after == -1) tail = f;
+    else prev[after] = f;
+}
+
+void LfuList::leaveGroup(int f) {
+    // Si f cerraba su grupo, el nuevo último es el anterior (si comparte contador)
+    int c = count[f];
+    if (lastOf[c] == f) lastOf[c] = (prev[f] != -1 && count[prev[f]] == c) ? prev[f] : -1;
+}
+
+void LfuList::insert(int f) {
+    // Detrás de los de contador 1 o, si no hay, de los envejecidos a 0
+    int anchor = lastOf[1] != -1 ? lastOf[1] : lastOf[0];
+    insertAfter(f, anchor);
+    count[f] = 1;
+    lastOf[1] = f;
+}
+
+void LfuList::touch(int f) {
+    int c = count[f];
+    if (c == MAX_COUNT) return;
+    // Final del grupo c+1 o, si no existe, del grupo c (los grupos van
+    // en orden creciente, así que ahí empezaría c+1)
+    int anchor = lastOf[c + 1] != -1 ? lastOf[c + 1] : lastOf[c];
+    leaveGroup(f);
+    if (anchor != f) {
+        unlink(f);
+        insertAfter(f, anchor);
+    }
+    count[f] = c + 1;
+    lastOf[c + 1] = f;
+}
+
+void LfuList::remove(int f) {
+    if (count[f] < 0) return;
+    leaveGroup(f);
+    unlink(f);
+    count[f] = -1;
+}
+
+void LfuList::age() {
+    // Dividir por 2 conserva el orden; sólo se recalculan los finales de grupo
+    std::fill(lastOf, lastOf + MAX_COUNT + 1, -1);
+    for (int f = head; f != -1; f = next[f]) {
+        count[f] >>= 1;
+        lastOf[count[f]] = f;
+    }
+}
+
+int LfuList::victim() const { return head; }
+
+int LfuList::getCount(int f) const { return count[f]; }
+
+void LfuList::save(SnapshotWriter &w) const {
+    std::vector<int> order, counts;
+    for (int f = head; f != -1; f = next[f]) {
+        order.push_back(f);
+        counts.push_back(count[f]);
+    }
+    w.putVector(order);
+    w.putVector(counts);
+}
+
+bool LfuList::load(SnapshotReader &r, const std::vector<Frame> &frames) {
+    std::vector<int> order, counts;
+    if (!r.getVector(order) || !r.getVector(counts)) return false;
+    int n = frames.size();
+    if (order.size() != counts.size() || (int)order.size() != occupiedFrames(frames)) return r.fail();
+    reset(n);
+    for (size_t i = 0; i < order.size(); i++) {
+        int f = order[i], c = counts[i];
+        if (f < 0 || f >= n || frames[f].pid == -1 || count[f] != -1 || c < 0 || c > MAX_COUNT ||
+            (tail != -1 && count[tail] > c))
+            return r.fail();
+        insertAfter(f, tail);
+        count[f] = c;
+        lastOf[c] = f;
+    }
+    return true;
+}
+
+// ========== ARC ==========
+
+ArcLists::ArcLists() { reset(0); }
+
+void ArcLists::reset(int frames) {
+    capacity = frames;
+    target = 0;
+    fPrev.assign(frames, -1);
+    fNext.assign(frames, -1);
+    fList.assign(frames, NONE);
+    // |B1| + |B2| <= c: un pool de c nodos alcanza
+    ghosts.assign(frames, Ghost{-1, -1, -1, -1, NONE});
+    freeGhosts.clear();
+    for (int i = frames - 1; i >= 0; i--) freeGhosts.push_back(i);
+    ghostIndex.reset(frames);
+    std::fill(head, head + 4, -1);
+    std::fill(tail, tail + 4, -1);
+    std::fill(length, length + 4, 0);
+    pendingList = T1;
+}
+
+int &ArcLists::prevOf(int list, int node) {
+    return list == B1 || list == B2 ? ghosts[node].prev : fPrev[node];
+}
+
+int &ArcLists::nextOf(int list, int node) {
+    return list == B1 || list == B2 ? ghosts[node].next : fNext[node];
+}
+
+void ArcLists::pushMRU(int list, int node) {
+    prevOf(list, node) = tail[list];
+    nextOf(list, node) = -1;
+    if (tail[list] == -1) head[list] = node;
+    else nextOf(list, tail[list]) = node;
+    tail[list] = node;
+    length[list]++;
+    if (list == T1 || list == T2) fList[node] = list;
+    else ghosts[node].list = list;
+}
+
+void ArcLists::unlink(int list, int node) {
+    int p = prevOf(list, node), n = nextOf(list, node);
+    if (p == -1) head[list] = n;
+    else nextOf(list, p) = n;
+    if (n == -1) tail[list] = p;
+    else prevOf(list, n) = p;
+    prevOf(list, node) = nextOf(list, node) = -1;
+    length[list]--;
+    if (list == T1 || list == T2) fList[node] = NONE;
+    else ghosts[node].list = NONE;
+}
+
+void ArcLists::addGhost(int list, int pid, int page) {
+    if (ghosts.empty()) return;
+    // No debería faltar lugar; por las dudas se recicla el fantasma más viejo
+    if (freeGhosts.empty()) dropGhost(head[length[B1] > 0 ? B1 : B2]);
+    int node = freeGhosts.back();
+    freeGhosts.pop_back();
+    ghosts[node].pid = pid;
+    ghosts[node].page = page;
+    ghostIndex.insert(pid, page, node, 0);
+    pushMRU(list, node);
+}
+
+void ArcLists::dropGhost(int node) {
+    unlink(ghosts[node].list, node);
+    ghostIndex.erase(ghosts[node].pid, ghosts[node].page);
+    freeGhosts.push_back(node);
+}
+
+int ArcLists::replace(bool inB2, const std::vector<Frame> &frames) {
+    // REPLACE(x, p) del artículo: sale de T1 si supera el objetivo
+    bool fromT1 = length[T2] == 0 ||
+                  (length[T1] > 0 && ((inB2 && length[T1] == target) || length[T1] > target));
+    int list = fromT1 ? T1 : T2;
+    int victim = head[list];
+    unlink(list, victim);
+    addGhost(fromT1 ? B1 : B2, frames[victim].pid, frames[victim].page);
+    return victim;
+}
+
+void ArcLists::hit(int frame) {
+    if (fList[frame] == NONE) return;
+    unlink(fList[frame], frame);
+    pushMRU(T2, frame);
+}
+
+int ArcLists::fault(int pid, int page, bool full, const std::vector<Frame> &frames) {
+    int victim = -1;
+
+    // Casos II y III: fantasma en B1 (recencia) o B2 (frecuencia)
+    if (PageTable::Entry *e = ghostIndex.find(pid, page)) {
+        int node = e->frame;
+        bool inB2 = ghosts[node].list == B2;
+        if (!inB2) target = std::min(capacity, target + std::max(length[B2] / length[B1], 1));
+        else target = std::max(0, target - std::max(length[B1] / length[B2], 1));
+        dropGhost(node);
+        if (full) victim = replace(inB2, frames);
+        pendingList = T2;
+        return victim;
+    }
+
+    // Caso IV: página nueva
+    pendingList = T1;
+    int l1 = length[T1] + length[B1];
+    int total = l1 + length[T2] + length[B2];
+    if (l1 >= capacity) {
+        if (length[T1] < capacity) {
+            if (length[B1] > 0) dropGhost(head[B1]);
+            if (full) victim = replace(false, frames);
+        } else {
+            // T1 ocupa toda la memoria: sale su LRU sin dejar fantasma
+            victim = head[T1];
+            unlink(T1, victim);
+        }
+    } else if (total >= capacity) {
+        if (total >= 2 * capacity && length[B2] > 0) dropGhost(head[B2]);
+        if (full) victim = replace(false, frames);
+    }
+    return victim;
+}
+
+void ArcLists::place(int frame) { pushMRU(pendingList, frame); }
+
+void ArcLists::removeFrame(int frame) {
+    if (fList[frame] != NONE) unlink(fList[frame], frame);
+}
+
+void ArcLists::forgetPid(int pid) {
+    for (size_t i = 0; i < ghosts.size(); i++)
+        if (ghosts[i].list != NONE && ghosts[i].pid == pid) dropGhost(i);
+}
+
+int ArcLists::getTarget() const { return target; }
+int ArcLists::sizeT1() const { return length[T1]; }
+int ArcLists::sizeT2() const { return length[T2]; }
+int ArcLists::ghostCount() const { return length[B1] + length[B2]; }
+
+void ArcLists::save(SnapshotWriter &w) const {
+    w.put(target);
+    for (int list = T1; list <= B2; list++) {
+        w.put<uint64_t>(length[list]);
+        for (int node = head[list]; node != -1;) {
+            if (list == T1 || list == T2) {
+                w.put(node);
+                node = fNext[node];
+            } else {
+                w.put(ghosts[node].pid);
+                w.put(ghosts[node].page);
+                node = ghosts[node].next;
+            }
+        }
+    }
+}
+
+bool ArcLists::load(SnapshotReader &r, const std::vector<Frame> &frames) {
+    reset(frames.size());
+    int p;
+    if (!r.get(p)) return false;
+    if (p < 0 || p > capacity) return r.fail();
+    target = p;
+    for (int list = T1; list <= B2; list++) {
+        bool resident = list == T1 || list == T2;
+        uint64_t n;
+        if (!r.getCount(n, resident ? sizeof(int) : 2 * sizeof(int))) return false;
+        for (uint64_t i = 0; i < n; i++) {
+            if (resident) {
+                int f;
+                if (!r.get(f)) return false;
+                if (f < 0 || f >= capacity || frames[f].pid == -1 || fList[f] != NONE)
+                    return r.fail();
+                pushMRU(list, f);
+            } else {
+                int pid, page;
+                if (!r.get(pid) || !r.get(page)) return false;
+                if (freeGhosts.empty() || ghostIndex.find(pid, page)) return r.fail();
+                addGhost(list, pid, page);
+            }
+        }
+    }
+    if (length[T1] + length[T2] != occupiedFrames(frames) || length[T1] + length[B1] > capacity)
+        return r.fail();
+    return true;
+}
+
+// ========== CONJUNTOS RESIDENTES POR PROCESO ==========
+
+void ResidentSets::reset(int frames) {
+    prev.assign(frames, -1);
+    next.assign(frames, -1);
+    lastUse.assign(frames, 0);
+    linked.assign(frames, 0);
+    sets.clear();
+}
+
+ResidentSet &ResidentSets::of(int pid) {
+    auto it = sets.find(pid);
+    if (it != sets.end()) return it->second;
+    ResidentSet &rs = sets[pid];
+    rs = ResidentSet{pid, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    return rs;
+}
+
+ResidentSet *ResidentSets::find(int pid) {
+    auto it = sets.find(pid);
+    return it == sets.end() ? nullptr : &it->second;
+}
+
+const ResidentSet *ResidentSets::find(int pid) const {
+    return const_cast<ResidentSets *>(this)->find(pid);
+}
+
+void ResidentSets::erase(int pid) { sets.erase(pid); }
+
+int ResidentSets::size() const { return sets.size(); }
+
+void ResidentSets::link(ResidentSet &rs, int frame) {
+    prev[frame] = rs.tail;
+    next[frame] = -1;
+    if (rs.tail == -1) rs.head = frame;
+    else next[rs.tail] = frame;
+    rs.tail = frame;
+    rs.listed++;
+    lastUse[frame] = rs.virtualTime;
+    linked[frame] = 1;
+}
+
+void ResidentSets::unlink(ResidentSet &rs, int frame) {
+    if (!linked[frame]) return;
+    if (prev[frame] == -1) rs.head = next[frame];
+    else next[prev[frame]] = next[frame];
+    if (next[frame] == -1) rs.tail = prev[frame];
+    else prev[next[frame]] = prev[frame];
+    prev[frame] = next[frame] = -1;
+    rs.listed--;
+    linked[frame] = 0;
+}
+
+void ResidentSets::touch(ResidentSet &rs, int frame) {
+    if (frame != rs.tail) {
+        unlink(rs, frame);
+        link(rs, frame);
+    }
+    lastUse[frame] = rs.virtualTime;
+}
+
+std::vector<const ResidentSet *> ResidentSets::sorted() const {
+    std::vector<const ResidentSet *> out;
+    for (const auto &entry : sets) out.push_back(&entry.second);
+    std::sort(out.begin(), out.end(),
+              [](const ResidentSet *a, const ResidentSet *b) { return a->pid < b->pid; });
+    return out;
+}
+
+void ResidentSets::save(SnapshotWriter &w) const {
+    std::vector<const ResidentSet *> order = sorted();
+    w.put<uint64_t>(order.size());
+    for (const ResidentSet *rs : order) {
+        w.put(*rs);
+        std::vector<int> list;
+        for (int f = rs->head; f != -1; f = next[f]) list.push_back(f);
+        w.putVector(list);
+    }
+    w.putVector(lastUse);
+}
+
+bool ResidentSets::load(SnapshotReader &r, const std::vector<Frame> &frames) {
+    int n = frames.size();
+    reset(n);
+    uint64_t count;
+    if (!r.getCount(count, sizeof(ResidentSet))) return false;
+    for (uint64_t i = 0; i < count; i++) {
+        ResidentSet saved;
+        std::vector<int> list;
+        if (!r.get(saved) || !r.getVector(list)) return false;
+        if (sets.count(saved.pid) || (int)list.size() != saved.listed || saved.resident < saved.listed ||
+            saved.allocation < 0 || saved.virtualTime < 0)
+            return r.fail();
+        ResidentSet &rs = sets[saved.pid];
+        rs = saved;
+        rs.head = rs.tail = -1;
+        rs.listed = 0;
+        for (int f : list) {
+            if (f < 0 || f >= n || frames[f].pid != rs.pid || linked[f]) return r.fail();
+            link(rs, f);
+        }
+    }
+    std::vector<int> uses;
+    if (!r.getVector(uses)) return false;
+    if ((int)uses.size() != n) return r.fail();
+    lastUse = std::move(uses);
+    // Cada marco ocupado cuenta en el conjunto de su dueño
+    std::map<int, int> owned;
+    for (const Frame &fr : frames)
+        if (fr.pid != -1) owned[fr.pid]++;
+    for (const auto &entry : sets)
+        if (entry.second.resident != (owned.count(entry.first) ? owned[entry.first] : 0)) return r.fail();
+    for (const auto &o : owned)
+        if (!sets.count(o.first)) return r.fail();
+    return true;
+}
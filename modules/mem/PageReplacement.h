@@ -0,0 +1,205 @@
+#ifndef PAGE_REPLACEMENT_H
+#define PAGE_REPLACEMENT_H
+
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include "PageTable.h"
+
+class SnapshotWriter;
+class SnapshotReader;
+struct Frame;
+
+// ========== LISTA DE MARCOS ==========
+/**
+ * Lista doblemente enlazada intrusiva sobre índices de marco (-1 = fin):
+ * enlazar, desenlazar y mover al final en O(1) sin memoria dinámica.
+ * La usan la recencia de LRU y el orden de carga de segunda oportunidad.
+ */
+class FrameList {
+private:
+    std::vector<int> prev;
+    std::vector<int> next;
+    std::vector<char> linked;
+    int first;
+    int last;
+
+public:
+    FrameList();
+
+    void reset(int frames);
+    void pushBack(int f);
+    void unlink(int f);                 // Sin efecto si f no está enlazado
+    int head() const { return first; }  // -1 si está vacía
+    int tail() const { return last; }
+    int after(int f) const { return next[f]; }
+    bool contains(int f) const { return linked[f]; }
+};
+
+// ========== LFU CON ENVEJECIMIENTO ==========
+/**
+ * Marcos ocupados en una lista ordenada por (contador, llegada al
+ * contador): la cabeza es la víctima (menos usada y, entre iguales, la que
+ * hace más que tiene ese contador).
+ * - lastOf[c] apunta al último marco con contador c: subir un contador
+ *   mueve el marco al final del grupo siguiente en O(1).
+ * - Contadores saturados en MAX_COUNT.
+ * - age() divide todos los contadores por 2 sin reordenar (O(marcos));
+ *   MemoryManager la llama cada lfuAgingPeriod() accesos, O(1) amortizado.
+ */
+class LfuList {
+public:
+    static const int MAX_COUNT = 255;
+
+private:
+    std::vector<int> prev;
+    std::vector<int> next;
+    std::vector<int> count;             // -1 = marco fuera de la lista
+    int head;
+    int tail;
+    int lastOf[MAX_COUNT + 1];
+
+    void unlink(int f);
+    void insertAfter(int f, int anchor);        // anchor -1 = al frente
+    void leaveGroup(int f);
+
+public:
+    LfuList();
+
+    void reset(int frames);
+    void insert(int f);                 // Página recién cargada: contador 1
+    void touch(int f);                  // Acierto
+    void remove(int f);
+    void age();
+    int victim() const;                 // -1 si está vacía
+    int getCount(int f) const;
+
+    // Snapshot: marcos en orden de lista con su contador
+    void save(SnapshotWriter &w) const;
+    bool load(SnapshotReader &r, const std::vector<Frame> &frames);
+};
+
+// ========== ARC (Adaptive Replacement Cache) ==========
+/**
+ * Megiddo y Modha (2003). Con c marcos:
+ * - T1: residentes vistas una vez; T2: residentes vistas dos o más veces.
+ * - B1/B2: fantasmas (sólo la clave) de lo desalojado de T1/T2.
+ * - target (p) es el tamaño deseado de T1: un acierto en B1 lo agranda y
+ *   uno en B2 lo achica, así la caché se adapta entre recencia y frecuencia.
+ * Las listas residentes se enlazan sobre los índices de marco y las
+ * fantasma en un pool de c nodos con índice hash: todo O(1) por acceso.
+ */
+class ArcLists {
+private:
+    enum { T1, T2, B1, B2, NONE };
+
+    struct Ghost {
+        int pid;
+        int page;
+        int prev;
+        int next;
+        int list;                       // B1, B2 o NONE (libre)
+    };
+
+    int capacity;
+    int target;
+    std::vector<int> fPrev;             // Residentes: enlaces por marco
+    std::vector<int> fNext;
+    std::vector<int> fList;             // T1, T2 o NONE
+    std::vector<Ghost> ghosts;
+    std::vector<int> freeGhosts;
+    PageTable ghostIndex;               // (pid, página) -> nodo fantasma (campo frame)
+    int head[4];
+    int tail[4];
+    int length[4];
+    int pendingList;                    // Lista del próximo place() (T1 o T2)
+
+    // Listas genéricas: 'node' es un marco (T1/T2) o un nodo fantasma (B1/B2)
+    int &prevOf(int list, int node);
+    int &nextOf(int list, int node);
+    void pushMRU(int list, int node);
+    void unlink(int list, int node);
+    void addGhost(int list, int pid, int page);
+    void dropGhost(int node);
+    int replace(bool inB2, const std::vector<Frame> &frames);
+
+public:
+    ArcLists();
+
+    void reset(int frames);
+    void hit(int frame);
+    // Fallo de (pid, página): adapta target y recorta fantasmas. Con la
+    // memoria llena devuelve el marco a desalojar (ya fuera de T1/T2);
+    // si no, -1. Después de cargar la página llamar a place().
+    int fault(int pid, int page, bool full, const std::vector<Frame> &frames);
+    void place(int frame);
+    void removeFrame(int frame);
+    void forgetPid(int pid);            // Fantasmas de un proceso terminado
+
+    int getTarget() const;
+    int sizeT1() const;
+    int sizeT2() const;
+    int ghostCount() const;
+
+    // Snapshot: target y las cuatro listas de LRU a MRU
+    void save(SnapshotWriter &w) const;
+    bool load(SnapshotReader &r, const std::vector<Frame> &frames);
+};
+
+// ========== CONJUNTOS RESIDENTES POR PROCESO ==========
+// Estadísticas y asignación de un PID (sin relleno: va tal cual al snapshot)
+struct ResidentSet {
+    int pid;
+    int head;                   // Lista de recencia del proceso (-1 = vacía)
+    int tail;
+    int resident;               // Marcos ocupados (incluye los recortados por WS)
+    int listed;                 // Marcos en la lista (WS: dentro de la ventana τ)
+    int allocation;             // PFF: marcos asignados
+    int virtualTime;            // Accesos del proceso: el reloj de WS y PFF
+    int windowFaults;           // PFF: fallos en la ventana deslizante
+    int faults;
+    int peakResident;
+    uint64_t faultHistory;      // Bit 0 = último acceso (1 = fallo)
+    long long residentSum;      // Suma de 'resident' en cada acceso (promedio)
+};
+
+/**
+ * Marcos de cada proceso en su propia lista de recencia, enlazada sobre
+ * los índices de marco (cabeza = uso más antiguo), con el tiempo virtual
+ * del dueño en su último acceso. Los registros por PID viven en un hash:
+ * todo O(1) por acceso.
+ */
+class ResidentSets {
+private:
+    std::vector<int> prev;
+    std::vector<int> next;
+    std::vector<int> lastUse;
+    std::vector<char> linked;
+    std::unordered_map<int, ResidentSet> sets;
+
+public:
+    void reset(int frames);
+
+    ResidentSet &of(int pid);           // Lo crea vacío (asignación 0) si no existe
+    ResidentSet *find(int pid);
+    const ResidentSet *find(int pid) const;
+    void erase(int pid);
+    int size() const;
+
+    void link(ResidentSet &rs, int frame);      // Al final, usado ahora
+    void unlink(ResidentSet &rs, int frame);    // Sin efecto si no está en la lista
+    void touch(ResidentSet &rs, int frame);
+    int useOf(int frame) const { return lastUse[frame]; }
+    bool contains(int frame) const { return linked[frame]; }
+
+    std::vector<const ResidentSet *> sorted() const;        // Por PID
+    template <class Visit> void forEach(Visit &&visit) {
+        for (auto &entry : sets) visit(entry.second);
+    }
+
+    // Snapshot: registros por PID con su lista y el último uso de cada marco
+    void save(SnapshotWriter &w) const;
+    bool load(SnapshotReader &r, const std::vector<Frame> &frames);
+};
+
+#endif // PAGE_REPLACEMENT_H
@@ -0,0 +1,118 @@
+#ifndef PAGE_TABLE_H
+#define PAGE_TABLE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// ========== TABLA DE PÁGINAS HASH ==========
+/**
+ * Tabla (pid, página) -> marco con direccionamiento abierto y sondeo lineal.
+ * - Cada entrada lleva inline el marco (-1 = vacía) y el último uso, así un
+ *   acierto es una sola línea de caché sin punteros.
+ * - Capacidad potencia de 2 con factor de carga <= 1/2; se dimensiona con
+ *   reset() según los marcos y no reserva memoria en régimen estable.
+ * - Borrado por desplazamiento hacia atrás: sin lápidas que alarguen las
+ *   búsquedas.
+ */
+class PageTable {
+public:
+    struct Entry {
+        uint64_t key;           // (pid << 32) | página
+        int frame;              // Marco asignado (-1 = entrada vacía)
+        int lastUse;            // Acceso más reciente (LRU)
+    };
+
+private:
+    std::vector<Entry> slots;
+    uint64_t mask;
+    int count;
+
+    static uint64_t makeKey(int pid, int page) {
+        return ((uint64_t)(uint32_t)pid << 32) | (uint32_t)page;
+    }
+
+    size_t home(uint64_t key) const {
+        return (key * 0x9E3779B97F4A7C15ULL >> 32) & mask;
+    }
+
+    void grow() {
+        std::vector<Entry> old;
+        old.swap(slots);
+        slots.assign(old.size() * 2, Entry{0, -1, 0});
+        mask = slots.size() - 1;
+        count = 0;
+        for (const Entry &e : old)
+            if (e.frame >= 0) place(e);
+    }
+
+    Entry &place(const Entry &e) {
+        size_t i = home(e.key);
+        while (slots[i].frame >= 0) i = (i + 1) & mask;
+        slots[i] = e;
+        count++;
+        return slots[i];
+    }
+
+public:
+    explicit PageTable(int maxEntries = 0) { reset(maxEntries); }
+
+    // Vacía la tabla con capacidad para maxEntries páginas residentes
+    void reset(int maxEntries) {
+        size_t cap = 8;
+        while (cap < 2 * (size_t)(maxEntries > 0 ? maxEntries : 0)) cap *= 2;
+        slots.assign(cap, Entry{0, -1, 0});
+        mask = cap - 1;
+        count = 0;
+    }
+
+    Entry *find(int pid, int page) {
+        uint64_t key = makeKey(pid, page);
+        for (size_t i = home(key); slots[i].frame >= 0; i = (i + 1) & mask)
+            if (slots[i].key == key) return &slots[i];
+        return nullptr;
+    }
+
+    const Entry *find(int pid, int page) const {
+        return const_cast<PageTable *>(this)->find(pid, page);
+    }
+
+    // La clave no debe estar presente
+    Entry &insert(int pid, int page, int frame, int lastUse) {
+        if (2 * (size_t)(count + 1) > slots.size()) grow();
+        return place(Entry{makeKey(pid, page), frame, lastUse});
+    }
+
+    bool erase(int pid, int page) {
+        uint64_t key = makeKey(pid, page);
+        size_t i = home(key);
+        while (slots[i].frame >= 0 && slots[i].key != key) i = (i + 1) & mask;
+        if (slots[i].frame < 0) return false;
+        // Desplazar hacia atrás las entradas cuyo hogar no queda entre el
+        // hueco y su posición actual
+        size_t hole = i;
+        for (size_t j = (i + 1) & mask; slots[j].frame >= 0; j = (j + 1) & mask) {
+            size_t h = home(slots[j].key);
+            if (((j - h) & mask) >= ((j - hole) & mask)) {
+                slots[hole] = slots[j];
+                hole = j;
+            }
+        }
+        slots[hole].frame = -1;
+        count--;
+        return true;
+    }
+
+    int size() const { return count; }
+
+    static int pidOf(const Entry &e) { return (int)(uint32_t)(e.key >> 32); }
+    static int pageOf(const Entry &e) { return (int)(uint32_t)e.key; }
+
+    // Visita las entradas válidas (orden de la tabla, no de clave)
+    template <class Visit> void forEach(Visit &&visit) const {
+        for (const Entry &e : slots)
+            if (e.frame >= 0) visit(e);
+    }
+};
+
+#endif // PAGE_TABLE_H
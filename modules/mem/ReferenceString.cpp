@@ -0,0 +1,115 @@
+#include "ReferenceString.h"
+#include "MemoryManager.h"
+#include "PageTable.h"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+
+std::vector<int> computeNextUse(const std::vector<PageRef> &refs) {
+    // Recorriendo hacia atrás, la tabla guarda en 'frame' la posición más
+    // temprana vista de cada (pid, página): ése es el próximo uso
+    std::vector<int> next(refs.size());
+    PageTable seen;
+    for (size_t i = refs.size(); i-- > 0;) {
+        if (PageTable::Entry *e = seen.find(refs[i].pid, refs[i].page)) {
+            next[i] = e->frame;
+            e->frame = i;
+        } else {
+            next[i] = NO_NEXT_USE;
+            seen.insert(refs[i].pid, refs[i].page, i, 0);
+        }
+    }
+    return next;
+}
+
+bool loadReferenceString(const std::string &path, std::vector<PageRef> &refs, std::string *error) {
+    std::ifstream in(path);
+    if (!in) {
+        if (error) *error = "no se pudo abrir " + path;
+        return false;
+    }
+    std::vector<PageRef> next;
+    std::string text;
+    for (long long line = 1; std::getline(in, text); line++) {
+        size_t hash = text.find('#');
+        if (hash != std::string::npos) text.resize(hash);
+        std::istringstream fields(text);
+        PageRef r{0, 0, false};
+        std::string kind;
+        if (!(fields >> r.pid)) {
+            if (fields.eof()) continue;         // Línea vacía o sólo comentario
+        } else if (fields >> r.page && r.pid >= 0 && r.page >= 0) {
+            if (!(fields >> kind) || kind == "r" || kind == "R") kind.clear();
+            if (kind.empty() || kind == "w" || kind == "W") {
+                r.write = !kind.empty();
+                next.push_back(r);
+                continue;
+            }
+        }
+        if (error) *error = "línea " + std::to_string(line) + ": se esperaba 'pid página [w]'";
+        return false;
+    }
+    refs = std::move(next);
+    return true;
+}
+
+bool saveReferenceString(const std::string &path, const std::vector<PageRef> &refs, std::string *error) {
+    std::ofstream out(path);
+    if (!out) {
+        if (error) *error = "no se pudo crear " + path;
+        return false;
+    }
+    out << "# pid página [w]\n";
+    for (const PageRef &r : refs) {
+        out << r.pid << ' ' << r.page;
+        if (r.write) out << " w";
+        out << '\n';
+    }
+    if (!out) {
+        if (error) *error = "error de escritura en " + path;
+        return false;
+    }
+    return true;
+}
+
+// ========== COMPARACIÓN CONTRA OPT ==========
+
+std::vector<ReplacementResult> compareWithOptimal(const std::vector<PageRef> &refs, int frames) {
+    std::vector<ReplacementResult> results;
+    for (int a = 0; a < PAGE_ALGO_COUNT; a++) {
+        PageAlgo algo = (PageAlgo)a;
+        if (algo == PageAlgo::OPT) continue;
+        MemoryManager mem(frames, algo);
+        for (const PageRef &r : refs) mem.access(r.pid, r.page, r.write);
+        results.push_back({algo, mem.getTotalFaults(), mem.getWriteBacks()});
+    }
+    MemoryManager opt(frames);
+    opt.setOptimalReferences(refs);
+    for (const PageRef &r : refs) opt.access(r.pid, r.page, r.write);
+    results.push_back({PageAlgo::OPT, opt.getTotalFaults(), opt.getWriteBacks()});
+    return results;
+}
+
+void showOptimalComparison(const std::vector<PageRef> &refs, int frames) {
+    std::vector<ReplacementResult> results = compareWithOptimal(refs, frames);
+    int optFaults = results.back().faults;
+
+    std::cout << "\n╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║         REEMPLAZO DE PÁGINAS VS. ÓPTIMO (OPT)      ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n";
+    std::cout << "Referencias: " << refs.size() << " | Marcos: " << frames << "\n";
+    std::cout << "\n┌──────────────────┬─────────┬────────────┬────────────┐\n";
+    std::cout << "│ Algoritmo        │ Fallos  │ Escrituras │ Fallos/OPT │\n";
+    std::cout << "├──────────────────┼─────────┼────────────┼────────────┤\n";
+    for (const ReplacementResult &r : results) {
+        std::cout << "│ " << std::left << std::setw(16) << pageAlgoName(r.algo) << std::right
+                  << " │ " << std::setw(7) << r.faults
+                  << " │ " << std::setw(10) << r.writeBacks << " │ ";
+        if (optFaults > 0) std::cout << std::setw(10) << std::fixed << std::setprecision(3)
+                                     << (double)r.faults / optFaults;
+        else std::cout << std::setw(10) << "-";
+        std::cout << " │\n";
+    }
+    std::cout << "└──────────────────┴─────────┴────────────┴────────────┘\n";
+}
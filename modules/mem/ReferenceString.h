@@ -0,0 +1,40 @@
+#ifndef REFERENCE_STRING_H
+#define REFERENCE_STRING_H
+
+#include <vector>
+#include <string>
+#include <climits>
+
+enum class PageAlgo;
+
+// ========== CADENA DE REFERENCIAS ==========
+// Texto, una referencia por línea ('#' inicia un comentario):
+//   pid página [w]          w = escritura (marca el bit M)
+struct PageRef {
+    int pid;
+    int page;
+    bool write;
+};
+
+const int NO_NEXT_USE = INT_MAX;
+
+// Posición de la siguiente referencia a la misma (pid, página), o
+// NO_NEXT_USE si no vuelve a aparecer. Una pasada hacia atrás, O(n).
+std::vector<int> computeNextUse(const std::vector<PageRef> &refs);
+
+bool loadReferenceString(const std::string &path, std::vector<PageRef> &refs, std::string *error = nullptr);
+bool saveReferenceString(const std::string &path, const std::vector<PageRef> &refs, std::string *error = nullptr);
+
+// ========== COMPARACIÓN CONTRA OPT ==========
+struct ReplacementResult {
+    PageAlgo algo;
+    int faults;
+    int writeBacks;
+};
+
+// Reproduce la cadena con cada algoritmo en línea y con OPT (Belady) sobre
+// 'frames' marcos vacíos; OPT queda al final
+std::vector<ReplacementResult> compareWithOptimal(const std::vector<PageRef> &refs, int frames);
+void showOptimalComparison(const std::vector<PageRef> &refs, int frames);
+
+#endif // REFERENCE_STRING_H
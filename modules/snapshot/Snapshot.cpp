@@ -0,0 +1,308 @@
+#include "Snapshot.h"
+#include <fstream>
+#include <functional>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+static const char SNAPSHOT_MAGIC[4] = {'K', 'S', 'N', 'P'};
+static const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+static const size_t SNAPSHOT_HEADER_SIZE = 4 + 3 * sizeof(uint32_t);
+
+// ========== ARCHIVO MAPEADO ==========
+
+#ifdef _WIN32
+
+MappedFile::MappedFile() : data(nullptr), length(0), fileHandle(nullptr), mapHandle(nullptr) {}
+
+bool MappedFile::open(const std::string &path) {
+    close();
+    HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (f == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER sz;
+    if (!GetFileSizeEx(f, &sz) || sz.QuadPart == 0) {
+        CloseHandle(f);
+        return false;
+    }
+    HANDLE m = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void *view = m ? MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (m) CloseHandle(m);
+        CloseHandle(f);
+        return false;
+    }
+    fileHandle = f;
+    mapHandle = m;
+    data = static_cast<const char *>(view);
+    length = (size_t)sz.QuadPart;
+    return true;
+}
+
+void MappedFile::close() {
+    if (data) UnmapViewOfFile(data);
+    if (mapHandle) CloseHandle((HANDLE)mapHandle);
+    if (fileHandle) CloseHandle((HANDLE)fileHandle);
+    data = nullptr;
+    length = 0;
+    fileHandle = mapHandle = nullptr;
+}
+
+void MappedFile::adviseSequential() {}
+
+void MappedFile::release(size_t) {}
+
+#else
+
+MappedFile::MappedFile() : data(nullptr), length(0), fd(-1) {}
+
+bool MappedFile::open(const std::string &path) {
+    close();
+    int f = ::open(path.c_str(), O_RDONLY);
+    if (f < 0) return false;
+    struct stat st;
+    if (fstat(f, &st) != 0 || st.st_size == 0) {
+        ::close(f);
+        return false;
+    }
+    void *view = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, f, 0);
+    if (view == MAP_FAILED) {
+        ::close(f);
+        return false;
+    }
+    fd = f;
+    data = static_cast<const char *>(view);
+    length = st.st_size;
+    return true;
+}
+
+void MappedFile::close() {
+    if (data) munmap(const_cast<char *>(data), length);
+    if (fd >= 0) ::close(fd);
+    data = nullptr;
+    length = 0;
+    fd = -1;
+}
+
+void MappedFile::adviseSequential() {
+    if (data) madvise(const_cast<char *>(data), length, MADV_SEQUENTIAL);
+}
+
+void MappedFile::release(size_t upTo) {
+    // Las páginas del archivo se releen si se vuelven a tocar
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t n = std::min(upTo, length) / page * page;
+    if (data && n) madvise(const_cast<char *>(data), n, MADV_DONTNEED);
+}
+
+#endif
+
+MappedFile::~MappedFile() { close(); }
+
+// ========== GUARDADO ==========
+
+bool writeSnapshot(SnapshotWriter &w, const SimState &state, std::string *error) {
+    size_t start = w.size();
+    w.put(SNAPSHOT_MAGIC);
+    w.put(SNAPSHOT_VERSION);
+    w.put(SNAPSHOT_BYTE_ORDER);
+    size_t countAt = w.size();
+    w.put<uint32_t>(0);     // Secciones: se completa al final
+    uint32_t sections = 0;
+
+    if (state.sched) {
+        size_t at = w.beginSection(SNAPSHOT_SCHEDULER);
+        if (!state.sched->saveState(w)) {
+            if (error) *error = "la política de planificación no admite snapshot";
+            w.truncate(start);
+            return false;
+        }
+        w.endSection(at);
+        sections++;
+    }
+    if (state.mem) {
+        size_t at = w.beginSection(SNAPSHOT_MEMORY);
+        state.mem->save(w);
+        w.endSection(at);
+        sections++;
+    }
+    if (state.prodCons) {
+        size_t at = w.beginSection(SNAPSHOT_PRODCONS);
+        state.prodCons->save(w);
+        w.endSection(at);
+        sections++;
+    }
+    if (state.heap) {
+        size_t at = w.beginSection(SNAPSHOT_HEAP);
+        state.heap->save(w);
+        w.endSection(at);
+        sections++;
+    }
+    if (state.disk) {
+        size_t at = w.beginSection(SNAPSHOT_DISK);
+        state.disk->save(w);
+        w.endSection(at);
+        sections++;
+    }
+    if (state.io) {
+        size_t at = w.beginSection(SNAPSHOT_IO);
+        state.io->save(w);
+        w.endSection(at);
+        sections++;
+    }
+    w.patch(countAt, sections);
+    return true;
+}
+
+bool saveSnapshot(const std::string &path, const SimState &state, std::string *error) {
+    SnapshotWriter w;
+    if (!writeSnapshot(w, state, error)) return false;
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.write(w.data().data(), w.size())) {
+        if (error) *error = "no se pudo escribir el archivo";
+        return false;
+    }
+    return true;
+}
+
+// ========== IMAGEN ==========
+
+SnapshotImage::SnapshotImage() : base(nullptr), length(0), sections(0) {}
+
+bool SnapshotImage::open(const std::string &path) {
+    if (!file.open(path)) {
+        base = nullptr;
+        sections = 0;
+        error = "no se pudo abrir el archivo";
+        return false;
+    }
+    base = file.bytes();
+    length = file.size();
+    return parse();
+}
+
+bool SnapshotImage::openBuffer(const char *data, size_t n) {
+    file.close();
+    base = data;
+    length = n;
+    return parse();
+}
+
+bool SnapshotImage::parse() {
+    SnapshotReader r(base, length);
+    char magic[4];
+    uint32_t version, byteOrder;
+    if (!r.get(magic) || std::memcmp(magic, SNAPSHOT_MAGIC, 4) != 0) {
+        error = "no es un snapshot del simulador";
+    } else if (!r.get(version) || version != SNAPSHOT_VERSION) {
+        error = "versión de snapshot no soportada";
+    } else if (!r.get(byteOrder) || byteOrder != SNAPSHOT_BYTE_ORDER) {
+        error = "orden de bytes distinto al del host";
+    } else if (!r.get(sections)) {
+        error = "encabezado truncado";
+    } else {
+        // Recorrer las secciones una vez para validar sus longitudes
+        for (uint32_t i = 0; i < sections; i++) {
+            uint32_t tag;
+            uint64_t len;
+            SnapshotReader body;
+            if (!r.get(tag) || !r.get(len) || len > length || !r.sub(len, body)) {
+                error = "sección truncada";
+                break;
+            }
+        }
+        if (r.ok() && r.atEnd()) return true;
+        if (r.ok()) error = "datos sobrantes al final del archivo";
+    }
+    sections = 0;
+    base = nullptr;
+    length = 0;
+    file.close();
+    return false;
+}
+
+bool SnapshotImage::findSection(uint32_t tag, SnapshotReader &out) const {
+    if (!base) return false;
+    SnapshotReader r(base + SNAPSHOT_HEADER_SIZE, length - SNAPSHOT_HEADER_SIZE);
+    for (uint32_t i = 0; i < sections; i++) {
+        uint32_t t = 0;
+        uint64_t len = 0;
+        SnapshotReader body;
+        if (!r.get(t) || !r.get(len) || !r.sub(len, body)) return false;
+        if (t == tag) {
+            out = body;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SnapshotImage::hasSection(uint32_t tag) const {
+    SnapshotReader r;
+    return findSection(tag, r);
+}
+
+bool SnapshotImage::restore(const SimState &state) {
+    if (!base) {
+        error = "snapshot no abierto";
+        return false;
+    }
+    struct Part {
+        uint32_t tag;
+        const char *name;
+        std::function<bool(SnapshotReader &)> load;
+    };
+    std::vector<Part> parts;
+    if (state.sched)
+        parts.push_back({SNAPSHOT_SCHEDULER, "planificador",
+                         [&](SnapshotReader &r) { return state.sched->loadState(r); }});
+    if (state.mem)
+        parts.push_back({SNAPSHOT_MEMORY, "memoria",
+                         [&](SnapshotReader &r) { return state.mem->load(r); }});
+    if (state.prodCons)
+        parts.push_back({SNAPSHOT_PRODCONS, "productor-consumidor",
+                         [&](SnapshotReader &r) { return state.prodCons->load(r); }});
+    if (state.heap)
+        parts.push_back({SNAPSHOT_HEAP, "heap",
+                         [&](SnapshotReader &r) { return state.heap->load(r); }});
+    if (state.disk)
+        parts.push_back({SNAPSHOT_DISK, "disco",
+                         [&](SnapshotReader &r) { return state.disk->load(r); }});
+    if (state.io)
+        parts.push_back({SNAPSHOT_IO, "E/S",
+                         [&](SnapshotReader &r) { return state.io->load(r); }});
+
+    // Comprobar que todas las secciones pedidas existen antes de tocar nada
+    for (const Part &part : parts) {
+        if (!hasSection(part.tag)) {
+            error = std::string("el snapshot no contiene la sección de ") + part.name;
+            return false;
+        }
+    }
+    for (const Part &part : parts) {
+        SnapshotReader body;
+        findSection(part.tag, body);
+        if (!part.load(body) || !body.atEnd()) {
+            error = std::string("sección inválida o incompatible: ") + part.name;
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t SnapshotImage::size() const { return length; }
+const std::string &SnapshotImage::lastError() const { return error; }
+
+bool loadSnapshot(const std::string &path, const SimState &state, std::string *error) {
+    SnapshotImage image;
+    bool ok = image.open(path) && image.restore(state);
+    if (!ok && error) *error = image.lastError();
+    return ok;
+}
@@ -0,0 +1,101 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <string>
+#include <cstdint>
+#include "SnapshotIO.h"
+#include "../cpu/Scheduler.h"
+#include "../mem/MemoryManager.h"
+#include "../mem/HeapAllocator.h"
+#include "../disk/DiskScheduler.h"
+#include "../io/IOManager.h"
+
+// ========== FORMATO ==========
+// Encabezado: "KSNP", versión, marca de orden de bytes, cantidad de secciones.
+// Cada sección: etiqueta (4 bytes), longitud (8 bytes) y el estado del módulo.
+const uint32_t SNAPSHOT_VERSION = 7;     // 7: FIFO usa el orden de carga en lista
+
+const uint32_t SNAPSHOT_SCHEDULER = 0x44484353;    // "SCHD"
+const uint32_t SNAPSHOT_MEMORY = 0x4d4d454d;       // "MEMM"
+const uint32_t SNAPSHOT_PRODCONS = 0x4e4f4350;     // "PCON"
+const uint32_t SNAPSHOT_HEAP = 0x50414548;         // "HEAP"
+const uint32_t SNAPSHOT_DISK = 0x4b534944;         // "DISK"
+const uint32_t SNAPSHOT_IO = 0x474d4f49;           // "IOMG"
+
+// ========== ESTADO DEL SIMULADOR ==========
+// Módulos que entran en el snapshot; nullptr = no se guarda / no se restaura
+struct SimState {
+    SchedulerCore *sched = nullptr;
+    MemoryManager *mem = nullptr;
+    ProducerConsumer *prodCons = nullptr;
+    HeapAllocator *heap = nullptr;
+    DiskScheduler *disk = nullptr;
+    IOManager *io = nullptr;
+};
+
+// ========== ARCHIVO MAPEADO EN MEMORIA ==========
+class MappedFile {
+private:
+    const char *data;
+    size_t length;
+#ifdef _WIN32
+    void *fileHandle;
+    void *mapHandle;
+#else
+    int fd;
+#endif
+
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool open(const std::string &path);
+    void close();
+    // Lectura secuencial de archivos grandes (sin efecto en Windows)
+    void adviseSequential();
+    void release(size_t upTo);      // Descarta del mapeo las páginas ya leídas
+    const char *bytes() const { return data; }
+    size_t size() const { return length; }
+};
+
+// ========== IMAGEN DE SNAPSHOT ==========
+/**
+ * Snapshot abierto para restaurar. El archivo se mapea una sola vez y cada
+ * restore() deserializa directamente desde esa memoria, así un mismo
+ * estado "caliente" puede bifurcarse en muchos experimentos sin releerlo.
+ * - restore() es todo o nada por módulo: un módulo cuya sección es
+ *   inválida conserva su estado anterior.
+ * - Una política sin soporte de snapshot (MLFQ, CFS, RT, SMP) hace fallar
+ *   el guardado en lugar de producir un archivo incompleto.
+ */
+class SnapshotImage {
+private:
+    MappedFile file;
+    const char *base;           // Inicio del snapshot (archivo o buffer externo)
+    size_t length;
+    uint32_t sections;
+    std::string error;
+
+    bool findSection(uint32_t tag, SnapshotReader &out) const;
+    bool parse();
+
+public:
+    SnapshotImage();
+
+    bool open(const std::string &path);
+    // Snapshot embebido en memoria ajena (p. ej. una traza); no se copia
+    bool openBuffer(const char *data, size_t n);
+    bool restore(const SimState &state);
+    bool hasSection(uint32_t tag) const;
+    size_t size() const;
+    const std::string &lastError() const;
+};
+
+// Serializa los módulos presentes en state; false si alguno no lo soporta
+bool writeSnapshot(SnapshotWriter &w, const SimState &state, std::string *error = nullptr);
+bool saveSnapshot(const std::string &path, const SimState &state, std::string *error = nullptr);
+bool loadSnapshot(const std::string &path, const SimState &state, std::string *error = nullptr);
+
+#endif // SNAPSHOT_H
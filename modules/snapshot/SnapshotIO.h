@@ -0,0 +1,132 @@
+#ifndef SNAPSHOT_IO_H
+#define SNAPSHOT_IO_H
+
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+
+// ========== CODIFICACIÓN BINARIA DE SNAPSHOTS ==========
+/**
+ * Primitivas de (de)serialización que usa cada módulo en su save()/load().
+ * - Valores triviales en binario nativo (el encabezado del archivo valida
+ *   el orden de bytes), vectores como (cantidad, bloque contiguo). Los
+ *   tipos no pueden tener relleno: dos estados iguales dan bytes iguales.
+ * - El lector trabaja sobre memoria ya mapeada y nunca copia el archivo:
+ *   cada lectura comprueba límites y, si falla, el lector queda inválido.
+ */
+class SnapshotWriter {
+private:
+    std::vector<char> buf;
+
+public:
+    template <class T>
+    void put(const T &v) {
+        static_assert(std::has_unique_object_representations<T>::value,
+                      "put() requiere un tipo trivial sin relleno");
+        const char *p = reinterpret_cast<const char *>(&v);
+        buf.insert(buf.end(), p, p + sizeof(T));
+    }
+
+    template <class T>
+    void putVector(const std::vector<T> &v) {
+        static_assert(std::has_unique_object_representations<T>::value,
+                      "putVector() requiere un tipo trivial sin relleno");
+        put<uint64_t>(v.size());
+        const char *p = reinterpret_cast<const char *>(v.data());
+        buf.insert(buf.end(), p, p + v.size() * sizeof(T));
+    }
+
+    void putString(const std::string &s) {
+        put<uint32_t>(s.size());
+        buf.insert(buf.end(), s.begin(), s.end());
+    }
+
+    // Sección: etiqueta + longitud (se completa en endSection)
+    size_t beginSection(uint32_t tag) {
+        put(tag);
+        size_t at = buf.size();
+        put<uint64_t>(0);
+        return at;
+    }
+
+    void endSection(size_t at) { patch<uint64_t>(at, buf.size() - at - sizeof(uint64_t)); }
+
+    // Reescribe un valor ya emitido (contadores que se conocen al final)
+    template <class T>
+    void patch(size_t at, const T &v) { std::memcpy(&buf[at], &v, sizeof(T)); }
+
+    void truncate(size_t n) { buf.resize(n); }
+
+    const std::vector<char> &data() const { return buf; }
+    size_t size() const { return buf.size(); }
+};
+
+class SnapshotReader {
+private:
+    const char *cur;
+    const char *end;
+    bool valid;
+
+public:
+    SnapshotReader(const char *data = nullptr, size_t n = 0)
+        : cur(data), end(data + n), valid(data != nullptr || n == 0) {}
+
+    template <class T>
+    bool get(T &v) {
+        static_assert(std::is_trivially_copyable<T>::value, "get() requiere un tipo trivial");
+        if (!valid || (size_t)(end - cur) < sizeof(T)) return valid = false;
+        std::memcpy(&v, cur, sizeof(T));
+        cur += sizeof(T);
+        return true;
+    }
+
+    template <class T>
+    bool getVector(std::vector<T> &v) {
+        static_assert(std::is_trivially_copyable<T>::value, "getVector() requiere un tipo trivial");
+        uint64_t n;
+        if (!get(n) || n > (uint64_t)(end - cur) / sizeof(T)) return valid = false;
+        v.resize(n);
+        if (n) std::memcpy(v.data(), cur, n * sizeof(T));
+        cur += n * sizeof(T);
+        return true;
+    }
+
+    bool getString(std::string &s) {
+        uint32_t n;
+        if (!get(n) || n > (size_t)(end - cur)) return valid = false;
+        s.assign(cur, n);
+        cur += n;
+        return true;
+    }
+
+    // Cantidad de elementos de al menos minBytes cada uno (acota reservas)
+    bool getCount(uint64_t &n, size_t minBytes) {
+        if (!get(n) || n > (uint64_t)(end - cur) / minBytes) return valid = false;
+        return true;
+    }
+
+    // Separa los siguientes n bytes como un lector independiente
+    bool sub(size_t n, SnapshotReader &out) {
+        if (!valid || (size_t)(end - cur) < n) return valid = false;
+        out = SnapshotReader(cur, n);
+        cur += n;
+        return true;
+    }
+
+    bool fail() { return valid = false; }
+    bool ok() const { return valid; }
+    bool atEnd() const { return cur == end; }
+};
+
+// ========== ACCESO AL CONTENEDOR DE UNA priority_queue ==========
+// El arreglo subyacente ya es un heap válido: guardarlo tal cual preserva
+// el orden exacto de extracción, incluidos los empates.
+template <class PQ>
+struct HeapContainer : PQ {
+    static typename PQ::container_type &of(PQ &q) { return q.*(&HeapContainer::c); }
+    static const typename PQ::container_type &of(const PQ &q) { return q.*(&HeapContainer::c); }
+};
+
+#endif // SNAPSHOT_IO_H
@@ -0,0 +1,144 @@
+#include "SweepRunner.h"
+#include "ThreadPool.h"
+#include "../mem/HeapAllocator.h"
+#include "../cpu/Synchronization.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+SweepConfig::SweepConfig()
+    : policy(SchedPolicy::RR), quantum(DEFAULT_QUANTUM), frames(DEFAULT_NUM_FRAMES), algo(PageAlgo::FIFO),
+      bufferSize(DEFAULT_BUFFER_SIZE), numProcs(50), ticks(1000), seed(1),
+      heapSize(1024 * 64) {}
+
+SweepRunner::SweepRunner() : threadsUsed(0), wallMs(0) {}
+
+void SweepRunner::addConfig(const SweepConfig &cfg) { configs.push_back(cfg); }
+
+void SweepRunner::addGrid(const std::vector<int> &quanta, const std::vector<int> &frames,
+                          const std::vector<PageAlgo> &algos, const SweepConfig &base) {
+    for (int q : quanta)
+        for (int f : frames)
+            for (PageAlgo a : algos) {
+                SweepConfig cfg = base;
+                cfg.quantum = q;
+                cfg.frames = f;
+                cfg.algo = a;
+                configs.push_back(cfg);
+            }
+}
+
+void SweepRunner::clear() {
+    configs.clear();
+    results.clear();
+}
+
+// ========== SIMULACIÓN DE UN PUNTO ==========
+SweepResult SweepRunner::runOne(const SweepConfig &cfg) {
+    auto start = std::chrono::steady_clock::now();
+
+    // Instancias propias del punto: ningún estado compartido entre hilos
+    MemoryManager mem(cfg.frames, cfg.algo);
+    ProducerConsumer prodCons(cfg.bufferSize);
+    std::unique_ptr<SchedulerCore> owned(makeScheduler(cfg.policy, mem, prodCons, cfg.quantum));
+    SchedulerCore &sched = *owned;
+    HeapAllocator heap(cfg.heapSize, 64, false);
+
+    // Carga sintética determinista: llegadas repartidas en la primera mitad
+    std::mt19937 rng(cfg.seed);
+    std::vector<int> arrivals(cfg.numProcs);
+    for (int &a : arrivals) a = rng() % (cfg.ticks / 2 + 1);
+    std::sort(arrivals.begin(), arrivals.end());
+
+    std::vector<void *> blocks;
+    for (int arrival : arrivals) {
+        if (arrival > sched.getTick()) sched.runTicks(arrival - sched.getTick());
+
+        int roll = rng() % 10;
+        ProcType type = roll == 0 ? ProcType::PRODUCER
+                      : roll == 1 ? ProcType::CONSUMER : ProcType::NORMAL;
+        int burst = 1 + rng() % 20;
+        int pages = 1 + rng() % 8;
+        int pid = sched.createProcess(burst, pages, type);
+        if (roll == 2) {
+            for (int t = 0; t < 2; t++) sched.createThreadInProcess(pid, 1 + rng() % 10);
+        }
+        blocks.push_back(heap.allocate(64 + rng() % 4032));
+    }
+    if (cfg.ticks > sched.getTick()) sched.runTicks(cfg.ticks - sched.getTick());
+
+    // Liberar la mitad de los bloques para medir fragmentación del buddy
+    for (size_t i = 0; i < blocks.size(); i += 2) heap.deallocate(blocks[i]);
+
+    SweepResult r;
+    r.config = cfg;
+    r.sched = sched.getSummary();
+    r.pageAccesses = mem.getTotalAccesses();
+    r.pageFaults = mem.getTotalFaults();
+    r.hitRate = mem.getHitRate();
+    r.heapInternalFrag = heap.getInternalFragmentation();
+    r.heapExternalFrag = heap.getExternalFragmentation();
+    r.elapsedMs = std::chrono::duration<double, std::milli>(
+                      std::chrono::steady_clock::now() - start).count();
+    return r;
+}
+
+// ========== EJECUCIÓN EN PARALELO ==========
+void SweepRunner::run(int threads) {
+    auto start = std::chrono::steady_clock::now();
+    results.assign(configs.size(), SweepResult());
+
+    ThreadPool pool(threads);
+    threadsUsed = pool.size();
+    std::vector<std::future<void>> pending;
+    pending.reserve(configs.size());
+    for (size_t i = 0; i < configs.size(); i++) {
+        // Cada tarea escribe sólo su propia posición del vector de resultados
+        pending.push_back(pool.submit([this, i] { results[i] = runOne(configs[i]); }));
+    }
+    for (auto &f : pending) f.get();
+
+    wallMs = std::chrono::duration<double, std::milli>(
+                 std::chrono::steady_clock::now() - start).count();
+}
+
+const std::vector<SweepResult> &SweepRunner::getResults() const { return results; }
+
+size_t SweepRunner::size() const { return configs.size(); }
+
+void SweepRunner::showResults() const {
+    static const char *algoNames[] = {"FIFO", "LRU", "PFF", "CLK", "SC", "ECLK", "LFU", "ARC", "OPT", "WS"};
+
+    std::cout << "\n╔══════════════════════════════════════════════════════════════════════════════╗\n";
+    std::cout << "║                      BARRIDO DE PARÁMETROS - RESULTADOS                      ║\n";
+    std::cout << "╚══════════════════════════════════════════════════════════════════════════════╝\n";
+    std::cout << "\n┌─────┬────┬────────┬──────┬───────┬──────────┬──────────┬────────┬─────────┬─────────┐\n";
+    std::cout << "│  #  │ Q  │ Marcos │ Algo │ Term. │ Espera   │ Retorno  │ CPU %  │ Fallos  │ Hit %   │\n";
+    std::cout << "├─────┼────┼────────┼──────┼───────┼──────────┼──────────┼────────┼─────────┼─────────┤\n";
+
+    double cpuMs = 0;
+    for (size_t i = 0; i < results.size(); i++) {
+        const SweepResult &r = results[i];
+        std::cout << "│ " << std::setw(3) << i
+                  << " │ " << std::setw(2) << r.config.quantum
+                  << " │ " << std::setw(6) << r.config.frames
+                  << " │ " << std::setw(4) << algoNames[(int)r.config.algo]
+                  << " │ " << std::setw(5) << r.sched.finished
+                  << " │ " << std::setw(8) << std::fixed << std::setprecision(2) << r.sched.avgWaiting
+                  << " │ " << std::setw(8) << r.sched.avgTurnaround
+                  << " │ " << std::setw(6) << r.sched.cpuUtilization
+                  << " │ " << std::setw(7) << r.pageFaults
+                  << " │ " << std::setw(7) << r.hitRate << " │\n";
+        cpuMs += r.elapsedMs;
+    }
+    std::cout << "└─────┴────┴────────┴──────┴───────┴──────────┴──────────┴────────┴─────────┴─────────┘\n";
+
+    std::cout << "Política: " << (results.empty() ? "-" : schedPolicyName(results[0].config.policy))
+              << " | Puntos: " << results.size() << " | Hilos del host: " << threadsUsed
+              << " | Tiempo real: " << std::setprecision(1) << wallMs << " ms"
+              << " | Suma por punto: " << cpuMs << " ms"
+              << " | Aceleración: " << std::setprecision(2) << (wallMs > 0 ? cpuMs / wallMs : 0) << "x\n";
+}
@@ -0,0 +1,71 @@
+#ifndef SWEEP_RUNNER_H
+#define SWEEP_RUNNER_H
+
+#include <vector>
+#include <string>
+#include "../cpu/SchedulerPolicy.h"
+#include "../mem/MemoryManager.h"
+
+// ========== CONFIGURACIÓN DE UN PUNTO DEL BARRIDO ==========
+struct SweepConfig {
+    SchedPolicy policy;
+    int quantum;
+    int frames;
+    PageAlgo algo;
+    int bufferSize;
+    int numProcs;               // Procesos de la carga sintética
+    int ticks;                  // Ticks a simular
+    unsigned seed;              // Misma semilla = misma carga
+    size_t heapSize;
+
+    SweepConfig();
+};
+
+// ========== RESULTADO DE UN PUNTO ==========
+struct SweepResult {
+    SweepConfig config;
+    SchedulerSummary sched;
+    int pageAccesses;
+    int pageFaults;
+    double hitRate;
+    double heapInternalFrag;
+    double heapExternalFrag;
+    double elapsedMs;           // Tiempo real de la simulación en el host
+};
+
+// ========== BARRIDO DE PARÁMETROS ==========
+/**
+ * Ejecuta un conjunto de configuraciones independientes en paralelo.
+ * - Cada punto crea sus propios MemoryManager, ProducerConsumer,
+ *   planificador (makeScheduler) y HeapAllocator: no hay estado
+ *   compartido entre hilos.
+ * - Los puntos se reparten en un ThreadPool con un hilo por núcleo del host.
+ * - Los resultados se guardan en el orden de las configuraciones, así la
+ *   tabla final no depende del orden en que terminan los hilos.
+ */
+class SweepRunner {
+private:
+    std::vector<SweepConfig> configs;
+    std::vector<SweepResult> results;
+    int threadsUsed;
+    double wallMs;
+
+public:
+    SweepRunner();
+
+    void addConfig(const SweepConfig &cfg);
+    // Producto cartesiano quantum x marcos x algoritmo sobre una base
+    void addGrid(const std::vector<int> &quanta, const std::vector<int> &frames,
+                 const std::vector<PageAlgo> &algos, const SweepConfig &base = SweepConfig());
+    void clear();
+
+    // 0 hilos = uno por núcleo del host
+    void run(int threads = 0);
+    static SweepResult runOne(const SweepConfig &cfg);
+
+    const std::vector<SweepResult> &getResults() const;
+    size_t size() const;
+    void showResults() const;
+};
+
+#endif // SWEEP_RUNNER_H
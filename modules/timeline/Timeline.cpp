@@ -0,0 +1,206 @@
+#include "Timeline.h"
+#include <chrono>
+#include <cstdio>
+
+static const size_t TIMELINE_FLUSH_BYTES = 1 << 16;
+
+// ========== GRABADOR ==========
+
+TimelineRecorder::TimelineRecorder()
+    : mask(0), head(0), tail(0), stopping(false), active(false), usPerTick(1000),
+      curPid(-1), curTid(0), curStart(0), curEnd(0), events(0), stalls(0) {}
+
+TimelineRecorder::~TimelineRecorder() { stop(); }
+
+bool TimelineRecorder::start(const std::string &path, int microsPerTick, size_t capacity,
+                             std::string *error) {
+    stop();
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        if (error) *error = "no se pudo crear " + path;
+        return false;
+    }
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    size_t n = 1024;
+    while (n < capacity) n <<= 1;
+    ring.assign(n, TimelineRecord());
+    mask = n - 1;
+    head.store(0);
+    tail.store(0);
+    stopping.store(false);
+    usPerTick = microsPerTick > 0 ? microsPerTick : 1;
+    curPid = -1;
+    events = stalls = 0;
+    active = true;
+    writer = std::thread(&TimelineRecorder::writerLoop, this);
+    return true;
+}
+
+bool TimelineRecorder::stop() {
+    if (!active) return false;
+    flushSlice();
+    stopping.store(true, std::memory_order_release);
+    writer.join();
+    out << "\n]}\n";
+    out.close();
+    active = false;
+    return true;
+}
+
+bool TimelineRecorder::isActive() const { return active; }
+long long TimelineRecorder::getEventCount() const { return events; }
+long long TimelineRecorder::getStalls() const { return stalls; }
+
+void TimelineRecorder::push(TimelineEvent type, long long start, int dur, int pid, int tid, int arg) {
+    uint64_t h = head.load(std::memory_order_relaxed);
+    // Anillo lleno: esperar al escritor en lugar de perder el evento
+    if (h - tail.load(std::memory_order_acquire) > mask) {
+        stalls++;
+        while (h - tail.load(std::memory_order_acquire) > mask) std::this_thread::yield();
+    }
+    ring[h & mask] = {start, dur, pid, tid, arg, type};
+    head.store(h + 1, std::memory_order_release);
+    events++;
+}
+
+void TimelineRecorder::flushSlice() {
+    if (curPid < 0) return;
+    push(TimelineEvent::SLICE, curStart, (int)(curEnd - curStart), curPid, curTid, 0);
+    curPid = -1;
+}
+
+// ========== HOOKS ==========
+
+void TimelineRecorder::running(int tick, int pid, int tid) { runSlice(tick, 1, pid, tid); }
+
+void TimelineRecorder::runSlice(int firstTick, int ticks, int pid, int tid) {
+    long long start = firstTick - 1;
+    if (pid == curPid && tid == curTid && start == curEnd) {
+        curEnd += ticks;
+        return;
+    }
+    flushSlice();
+    curPid = pid;
+    curTid = tid;
+    curStart = start;
+    curEnd = start + ticks;
+}
+
+void TimelineRecorder::pageFault(int tick, int pid, int tid, int page) {
+    push(TimelineEvent::PAGE_FAULT, tick, 0, pid, tid, page);
+}
+
+void TimelineRecorder::preempt(int tick, int pid, bool quantum) {
+    push(TimelineEvent::PREEMPT, tick, 0, pid, 0, quantum);
+}
+
+void TimelineRecorder::block(int tick, int pid, int tid, int semaphore) {
+    push(TimelineEvent::BLOCK, tick, 0, pid, tid, semaphore);
+}
+
+void TimelineRecorder::wake(int tick, int pid, int tid) {
+    push(TimelineEvent::WAKE, tick, 0, pid, tid, 0);
+}
+
+void TimelineRecorder::item(int tick, int pid, int tid, bool produced) {
+    push(produced ? TimelineEvent::PRODUCE : TimelineEvent::CONSUME, tick, 0, pid, tid, 0);
+}
+
+void TimelineRecorder::processCreated(int tick, int pid, ProcType type) {
+    push(TimelineEvent::CREATE, tick, 0, pid, 0, (int)type);
+}
+
+void TimelineRecorder::processExited(int tick, int pid) {
+    push(TimelineEvent::EXIT, tick, 0, pid, 0, 0);
+}
+
+// ========== ESCRITOR JSON ==========
+
+void TimelineRecorder::writerLoop() {
+    std::string buf;
+    bool first = true;
+    while (true) {
+        uint64_t t = tail.load(std::memory_order_relaxed);
+        uint64_t h = head.load(std::memory_order_acquire);
+        if (t == h) {
+            // stop() marca stopping después del último push
+            if (stopping.load(std::memory_order_acquire) &&
+                head.load(std::memory_order_acquire) == t) break;
+            if (!buf.empty()) {
+                out.write(buf.data(), buf.size());
+                buf.clear();
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            continue;
+        }
+        for (; t < h; t++) writeRecord(ring[t & mask], buf, first);
+        tail.store(t, std::memory_order_release);
+        if (buf.size() >= TIMELINE_FLUSH_BYTES) {
+            out.write(buf.data(), buf.size());
+            buf.clear();
+        }
+    }
+    out.write(buf.data(), buf.size());
+}
+
+void TimelineRecorder::writeRecord(const TimelineRecord &r, std::string &buf, bool &first) {
+    char line[256];
+    long long ts = r.start * usPerTick;
+    int n = 0;
+    switch (r.type) {
+    case TimelineEvent::SLICE:
+        n = std::snprintf(line, sizeof(line),
+                          "{\"name\":\"CPU\",\"cat\":\"cpu\",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,"
+                          "\"pid\":%d,\"tid\":%d}",
+                          ts, (long long)r.dur * usPerTick, r.pid, r.tid);
+        break;
+    case TimelineEvent::PAGE_FAULT:
+        n = std::snprintf(line, sizeof(line),
+                          "{\"name\":\"fallo de página\",\"cat\":\"mem\",\"ph\":\"i\",\"s\":\"t\","
+                          "\"ts\":%lld,\"pid\":%d,\"tid\":%d,\"args\":{\"page\":%d}}",
+                          ts, r.pid, r.tid, r.arg);
+        break;
+    case TimelineEvent::PREEMPT:
+        n = std::snprintf(line, sizeof(line),
+                          "{\"name\":\"%s\",\"cat\":\"sched\",\"ph\":\"i\",\"s\":\"p\","
+                          "\"ts\":%lld,\"pid\":%d,\"tid\":%d}",
+                          r.arg ? "fin de quantum" : "expropiado", ts, r.pid, r.tid);
+        break;
+    case TimelineEvent::BLOCK:
+    case TimelineEvent::WAKE:
+        // Async: el bloqueo se dibuja como intervalo entre "b" y "e" (mismo
+        // nombre en ambos); sem = -1 es un sleepProcess
+        n = std::snprintf(line, sizeof(line),
+                          "{\"name\":\"espera\",\"cat\":\"sync\",\"ph\":\"%s\",\"id\":\"%d.%d\","
+                          "\"ts\":%lld,\"pid\":%d,\"tid\":%d,\"args\":{\"sem\":%d}}",
+                          r.type == TimelineEvent::BLOCK ? "b" : "e", r.pid, r.tid,
+                          ts, r.pid, r.tid, r.arg);
+        break;
+    case TimelineEvent::PRODUCE:
+    case TimelineEvent::CONSUME:
+        n = std::snprintf(line, sizeof(line),
+                          "{\"name\":\"%s\",\"cat\":\"sync\",\"ph\":\"i\",\"s\":\"t\","
+                          "\"ts\":%lld,\"pid\":%d,\"tid\":%d}",
+                          r.type == TimelineEvent::PRODUCE ? "produce" : "consume", ts, r.pid, r.tid);
+        break;
+    case TimelineEvent::CREATE:
+        n = std::snprintf(line, sizeof(line),
+                          "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,"
+                          "\"args\":{\"name\":\"PID %d (%s)\"}},\n"
+                          "{\"name\":\"creado\",\"cat\":\"sched\",\"ph\":\"i\",\"s\":\"p\","
+                          "\"ts\":%lld,\"pid\":%d,\"tid\":0}",
+                          r.pid, r.pid, procTypeName((ProcType)r.arg), ts, r.pid);
+        break;
+    case TimelineEvent::EXIT:
+        n = std::snprintf(line, sizeof(line),
+                          "{\"name\":\"terminado\",\"cat\":\"sched\",\"ph\":\"i\",\"s\":\"p\","
+                          "\"ts\":%lld,\"pid\":%d,\"tid\":0}",
+                          ts, r.pid);
+        break;
+    }
+    if (n <= 0) return;
+    if (!first) buf += ",\n";
+    first = false;
+    buf.append(line, std::min<size_t>(n, sizeof(line) - 1));
+}
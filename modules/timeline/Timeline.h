@@ -0,0 +1,101 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <fstream>
+#include <cstdint>
+#include "../cpu/Process.h"
+
+// ========== EVENTOS DE LA LÍNEA DE TIEMPO ==========
+enum class TimelineEvent : uint8_t {
+    SLICE,          // Tramo continuo en CPU de un PID/TID (evento completo "X")
+    PAGE_FAULT,     // arg = página
+    PREEMPT,        // arg = 1 fin de quantum, 0 expropiación de la política
+    BLOCK,          // Espera en semáforo o sleep (inicio async "b"); arg = semáforo, -1 = sleep
+    WAKE,           // Fin de la espera (async "e")
+    PRODUCE,
+    CONSUME,
+    CREATE,         // Metadato process_name; arg = ProcType
+    EXIT
+};
+
+struct TimelineRecord {
+    long long start;        // Tick de inicio
+    int dur;                // Ticks (sólo SLICE)
+    int pid;
+    int tid;                // 0 = el PCB (proceso sin hilos)
+    int arg;
+    TimelineEvent type;
+};
+
+// ========== GRABADOR ==========
+/**
+ * Línea de tiempo de la planificación en formato Chrome trace-event JSON
+ * (chrome://tracing, ui.perfetto.dev): cada PID es un proceso y cada TID
+ * una pista.
+ * - Los hooks corren en el hilo de la simulación: los ticks consecutivos
+ *   del mismo PID/TID se acumulan en un solo tramo y los eventos se
+ *   encolan en un anillo SPSC sin locks (índices atómicos).
+ * - Un hilo escritor vacía el anillo y formatea el JSON en streaming; si el
+ *   anillo se llena la simulación espera (no se pierden eventos).
+ * - Desactivado, el costo es el chequeo de un puntero nulo en cada hook
+ *   (SchedulerCore::setTimeline).
+ */
+class TimelineRecorder {
+private:
+    std::vector<TimelineRecord> ring;
+    size_t mask;
+    std::atomic<uint64_t> head;         // Próximo a escribir (simulación)
+    std::atomic<uint64_t> tail;         // Próximo a leer (escritor)
+    std::atomic<bool> stopping;
+    std::thread writer;
+    std::ofstream out;
+    bool active;
+    int usPerTick;
+
+    // Tramo en curso (sólo lo toca el hilo de la simulación)
+    int curPid;
+    int curTid;
+    long long curStart;
+    long long curEnd;
+
+    long long events;
+    long long stalls;
+
+    void push(TimelineEvent type, long long start, int dur, int pid, int tid, int arg);
+    void flushSlice();
+    void writerLoop();
+    void writeRecord(const TimelineRecord &r, std::string &buf, bool &first);
+
+public:
+    TimelineRecorder();
+    ~TimelineRecorder();
+    TimelineRecorder(const TimelineRecorder &) = delete;
+    TimelineRecorder &operator=(const TimelineRecorder &) = delete;
+
+    // capacity se redondea a potencia de dos
+    bool start(const std::string &path, int microsPerTick = 1000, size_t capacity = 1 << 16,
+               std::string *error = nullptr);
+    bool stop();
+    bool isActive() const;
+    long long getEventCount() const;
+    long long getStalls() const;        // Veces que el anillo estaba lleno
+
+    // Hooks del planificador. running/runSlice reciben globalTick ya
+    // avanzado (el tick ejecutado ocupa [tick - 1, tick)); el resto, el
+    // instante del evento en ticks.
+    void running(int tick, int pid, int tid);
+    void runSlice(int firstTick, int ticks, int pid, int tid);
+    void pageFault(int tick, int pid, int tid, int page);
+    void preempt(int tick, int pid, bool quantum);
+    void block(int tick, int pid, int tid, int semaphore);
+    void wake(int tick, int pid, int tid);
+    void item(int tick, int pid, int tid, bool produced);
+    void processCreated(int tick, int pid, ProcType type);
+    void processExited(int tick, int pid);
+};
+
+#endif // TIMELINE_H
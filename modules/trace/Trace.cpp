@@ -0,0 +1,615 @@
+#include "Trace.h"
+#include "Varint.h"
+#include <chrono>
+
+static const char TRACE_MAGIC[4] = {'K', 'T', 'R', 'C'};
+static const size_t TRACE_FLUSH_BYTES = 1 << 16;
+
+// ========== HASH DEL ESTADO ==========
+
+uint64_t stateHash(const SimState &state) {
+    SnapshotWriter w;
+    if (!writeSnapshot(w, state)) return 0;
+    uint64_t h = 1469598103934665603ULL;
+    for (char c : w.data()) {
+        h ^= (unsigned char)c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// ========== GRABADOR ==========
+
+TraceRecorder::TraceRecorder() : recording(false), lastTick(0), events(0) {}
+
+TraceRecorder::~TraceRecorder() { stop(); }
+
+void TraceRecorder::bind(const SimState &s) { state = s; }
+
+bool TraceRecorder::start(const std::string &path, SchedPolicy policy, std::string *error) {
+    stop();
+    SnapshotWriter initial;
+    if (!writeSnapshot(initial, state, error)) return false;
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        if (error) *error = "no se pudo crear el archivo";
+        return false;
+    }
+
+    uint32_t pol = (uint32_t)policy;
+    uint64_t len = initial.size();
+    pending.clear();
+    pending.insert(pending.end(), TRACE_MAGIC, TRACE_MAGIC + 4);
+    pending.insert(pending.end(), (const char *)&TRACE_VERSION, (const char *)&TRACE_VERSION + 4);
+    pending.insert(pending.end(), (const char *)&pol, (const char *)&pol + 4);
+    pending.insert(pending.end(), (const char *)&len, (const char *)&len + 8);
+    pending.insert(pending.end(), initial.data().begin(), initial.data().end());
+    flushPending();
+
+    recording = true;
+    lastTick = state.sched ? state.sched->getTick() : 0;
+    events = 0;
+    return true;
+}
+
+bool TraceRecorder::stop() {
+    if (!recording) return false;
+    begin(TraceOp::END);
+    uint64_t hash = stateHash(state);
+    pending.insert(pending.end(), (const char *)&hash, (const char *)&hash + 8);
+    putVarint(pending, events);
+    flushPending();
+    out.close();
+    recording = false;
+    return true;
+}
+
+bool TraceRecorder::isRecording() const { return recording; }
+long long TraceRecorder::getEventCount() const { return events; }
+
+void TraceRecorder::begin(TraceOp op) {
+    if (pending.size() >= TRACE_FLUSH_BYTES) flushPending();
+    int now = state.sched ? state.sched->getTick() : 0;
+    pending.push_back((char)op);
+    putVarint(pending, now - lastTick);
+    lastTick = now;
+    if (op != TraceOp::END) events++;
+}
+
+void TraceRecorder::flushPending() {
+    out.write(pending.data(), pending.size());
+    pending.clear();
+}
+
+// Cada operación: registro (opcode, tick) antes de aplicarla y argumentos
+// más resultado después; el log se vuelca por bloques de 64 KB
+
+int TraceRecorder::createProcess(int burst, int pages, ProcType type) {
+    if (!state.sched) return -1;
+    if (recording) begin(TraceOp::CREATE_PROCESS);
+    int pid = state.sched->createProcess(burst, pages, type);
+    if (recording) {
+        putSigned(pending, burst);
+        putSigned(pending, pages);
+        putVarint(pending, (uint64_t)type);
+        putSigned(pending, pid);
+    }
+    return pid;
+}
+
+bool TraceRecorder::killProcess(int pid) {
+    if (!state.sched) return false;
+    if (recording) begin(TraceOp::KILL_PROCESS);
+    bool ok = state.sched->killProcess(pid);
+    if (recording) {
+        putSigned(pending, pid);
+        putVarint(pending, ok);
+    }
+    return ok;
+}
+
+bool TraceRecorder::suspendProcess(int pid) {
+    if (!state.sched) return false;
+    if (recording) begin(TraceOp::SUSPEND_PROCESS);
+    bool ok = state.sched->suspendProcess(pid);
+    if (recording) {
+        putSigned(pending, pid);
+        putVarint(pending, ok);
+    }
+    return ok;
+}
+
+bool TraceRecorder::resumeProcess(int pid) {
+    if (!state.sched) return false;
+    if (recording) begin(TraceOp::RESUME_PROCESS);
+    bool ok = state.sched->resumeProcess(pid);
+    if (recording) {
+        putSigned(pending, pid);
+        putVarint(pending, ok);
+    }
+    return ok;
+}
+
+int TraceRecorder::createThreadInProcess(int pid, int burst) {
+    if (!state.sched) return -1;
+    if (recording) begin(TraceOp::CREATE_THREAD);
+    int tid = state.sched->createThreadInProcess(pid, burst);
+    if (recording) {
+        putSigned(pending, pid);
+        putSigned(pending, burst);
+        putSigned(pending, tid);
+    }
+    return tid;
+}
+
+bool TraceRecorder::setPriority(int pid, int nice) {
+    if (!state.sched) return false;
+    if (recording) begin(TraceOp::SET_PRIORITY);
+    bool ok = state.sched->setPriority(pid, nice);
+    if (recording) {
+        putSigned(pending, pid);
+        putSigned(pending, nice);
+        putVarint(pending, ok);
+    }
+    return ok;
+}
+
+int TraceRecorder::scheduleProcess(int arrivalTick, int burst, int pages, ProcType type) {
+    if (!state.sched) return -1;
+    if (recording) begin(TraceOp::SCHEDULE_PROCESS);
+    int pid = state.sched->scheduleProcess(arrivalTick, burst, pages, type);
+    if (recording) {
+        putSigned(pending, arrivalTick);
+        putSigned(pending, burst);
+        putSigned(pending, pages);
+        putVarint(pending, (uint64_t)type);
+        putSigned(pending, pid);
+    }
+    return pid;
+}
+
+int TraceRecorder::createPeriodicTask(int wcet, int period, int deadline, int pages) {
+    if (!state.sched) return -1;
+    if (recording) begin(TraceOp::CREATE_PERIODIC);
+    int pid = state.sched->createPeriodicTask(wcet, period, deadline, pages);
+    if (recording) {
+        putSigned(pending, wcet);
+        putSigned(pending, period);
+        putSigned(pending, deadline);
+        putSigned(pending, pages);
+        putSigned(pending, pid);
+    }
+    return pid;
+}
+
+bool TraceRecorder::sleepProcess(int pid, int ticks) {
+    if (!state.sched) return false;
+    if (recording) begin(TraceOp::SLEEP_PROCESS);
+    bool ok = state.sched->sleepProcess(pid, ticks);
+    if (recording) {
+        putSigned(pending, pid);
+        putSigned(pending, ticks);
+        putVarint(pending, ok);
+    }
+    return ok;
+}
+
+void TraceRecorder::setWaitTimeout(int ticks) {
+    if (!state.sched) return;
+    if (recording) {
+        begin(TraceOp::SET_WAIT_TIMEOUT);
+        putSigned(pending, ticks);
+    }
+    state.sched->setWaitTimeout(ticks);
+}
+
+void TraceRecorder::setAccessModel(AccessModel model, const AccessParams &params, uint64_t seed) {
+    if (!state.sched) return;
+    if (recording) {
+        begin(TraceOp::SET_ACCESS_MODEL);
+        putVarint(pending, (uint64_t)model);
+        putVarint(pending, seed);
+        putSigned(pending, params.wsPages);
+        putSigned(pending, params.phaseLength);
+        putSigned(pending, params.zipfSkew);
+        putSigned(pending, params.loopPages);
+        putSigned(pending, params.loopIterations);
+        putSigned(pending, params.stride);
+        putSigned(pending, params.writePercent);
+    }
+    state.sched->setAccessModel(model, params, seed);
+}
+
+bool TraceRecorder::setProcessAccessModel(int pid, AccessModel model) {
+    if (!state.sched) return false;
+    if (recording) begin(TraceOp::SET_PROCESS_ACCESS);
+    bool ok = state.sched->setProcessAccessModel(pid, model);
+    if (recording) {
+        putSigned(pending, pid);
+        putVarint(pending, (uint64_t)model);
+        putVarint(pending, ok);
+    }
+    return ok;
+}
+
+void TraceRecorder::tick() {
+    if (!state.sched) return;
+    if (recording) begin(TraceOp::TICK);
+    state.sched->tick();
+}
+
+void TraceRecorder::runTicks(int n) {
+    if (!state.sched) return;
+    if (recording) {
+        begin(TraceOp::RUN_TICKS);
+        putSigned(pending, n);
+    }
+    state.sched->runTicks(n);
+}
+
+void *TraceRecorder::heapAllocate(size_t size) {
+    if (!state.heap) return nullptr;
+    if (recording) begin(TraceOp::HEAP_ALLOC);
+    void *ptr = state.heap->allocate(size);
+    if (recording) {
+        putVarint(pending, size);
+        putVarint(pending, ptr ? reinterpret_cast<size_t>(ptr) + 1 : 0);
+    }
+    return ptr;
+}
+
+bool TraceRecorder::heapFree(void *ptr) {
+    if (!state.heap) return false;
+    if (recording) begin(TraceOp::HEAP_FREE);
+    bool ok = state.heap->deallocate(ptr);
+    if (recording) {
+        putVarint(pending, reinterpret_cast<size_t>(ptr));
+        putVarint(pending, ok);
+    }
+    return ok;
+}
+
+void TraceRecorder::diskRequest(int cylinder) {
+    if (!state.disk) return;
+    if (recording) {
+        begin(TraceOp::DISK_REQUEST);
+        putSigned(pending, cylinder);
+    }
+    state.disk->addRequest(cylinder);
+}
+
+int TraceRecorder::diskProcessNext() {
+    if (!state.disk) return -1;
+    if (recording) begin(TraceOp::DISK_PROCESS);
+    int cylinder = state.disk->processNext();
+    if (recording) putSigned(pending, cylinder);
+    return cylinder;
+}
+
+void TraceRecorder::ioRequest(int pid, int priority, const std::string &device, int duration) {
+    if (!state.io) return;
+    if (recording) {
+        begin(TraceOp::IO_REQUEST);
+        putSigned(pending, pid);
+        putSigned(pending, priority);
+        putVarint(pending, device.size());
+        pending.insert(pending.end(), device.begin(), device.end());
+        putSigned(pending, duration);
+    }
+    state.io->addIORequest(pid, priority, device, duration);
+}
+
+bool TraceRecorder::ioTick() {
+    if (!state.io) return false;
+    if (recording) begin(TraceOp::IO_TICK);
+    bool assigned = state.io->processIOTick();
+    if (recording) putVarint(pending, assigned);
+    return assigned;
+}
+
+void TraceRecorder::setNumFrames(int n) {
+    if (!state.mem) return;
+    if (recording) {
+        begin(TraceOp::SET_FRAMES);
+        putSigned(pending, n);
+    }
+    state.mem->setNumFrames(n);
+}
+
+void TraceRecorder::setPageAlgorithm(PageAlgo algo) {
+    if (!state.mem) return;
+    if (recording) {
+        begin(TraceOp::SET_PAGE_ALGO);
+        putVarint(pending, (uint64_t)algo);
+    }
+    state.mem->setAlgorithm(algo);
+}
+
+void TraceRecorder::setPFFParams(int high, int low, int window) {
+    if (!state.mem) return;
+    if (recording) {
+        begin(TraceOp::SET_PFF_PARAMS);
+        putSigned(pending, high);
+        putSigned(pending, low);
+        putSigned(pending, window);
+    }
+    state.mem->setPFFParams(high, low, window);
+}
+
+void TraceRecorder::setWorkingSetWindow(int tau) {
+    if (!state.mem) return;
+    if (recording) {
+        begin(TraceOp::SET_WS_WINDOW);
+        putSigned(pending, tau);
+    }
+    state.mem->setWorkingSetWindow(tau);
+}
+
+// ========== REPRODUCCIÓN ==========
+
+TraceReplayResult::TraceReplayResult()
+    : ok(false), complete(false), events(0), divergedAt(-1), finalTick(0),
+      recordedHash(0), replayHash(0), elapsedMs(0) {}
+
+TraceReplayer::TraceReplayer()
+    : mem(DEFAULT_NUM_FRAMES), prodCons(DEFAULT_BUFFER_SIZE), sched(nullptr),
+      heap(1024 * 64, 64, false) {}
+
+TraceReplayer::~TraceReplayer() { delete sched; }
+
+SimState TraceReplayer::getState() {
+    SimState s;
+    s.sched = sched;
+    s.mem = &mem;
+    s.prodCons = &prodCons;
+    s.heap = &heap;
+    s.disk = &disk;
+    s.io = &io;
+    return s;
+}
+
+TraceReplayResult TraceReplayer::replay(const std::string &path) {
+    TraceReplayResult res;
+    auto t0 = std::chrono::steady_clock::now();
+
+    MappedFile file;
+    if (!file.open(path)) {
+        res.error = "no se pudo abrir la traza";
+        return res;
+    }
+    TraceCursor in(file.bytes(), file.size());
+    const char *magic, *snap;
+    uint32_t version, pol;
+    uint64_t snapLen;
+    if (!in.bytes(4, magic) || std::memcmp(magic, TRACE_MAGIC, 4) != 0 ||
+        !in.fixed(version) || !in.fixed(pol) || !in.fixed(snapLen)) {
+        res.error = "no es una traza del simulador";
+        return res;
+    }
+    if (version != TRACE_VERSION || pol >= (uint32_t)SCHED_POLICY_COUNT) {
+        res.error = "versión de traza no soportada";
+        return res;
+    }
+    if (snapLen > file.size() || !in.bytes(snapLen, snap)) {
+        res.error = "snapshot inicial truncado";
+        return res;
+    }
+
+    // Módulos presentes en el snapshot inicial, con la política grabada
+    delete sched;
+    sched = makeScheduler((SchedPolicy)pol, mem, prodCons);
+    SnapshotImage image;
+    if (!image.openBuffer(snap, snapLen)) {
+        res.error = image.lastError();
+        return res;
+    }
+    SimState full = getState(), state;
+    if (image.hasSection(SNAPSHOT_SCHEDULER)) state.sched = full.sched;
+    if (image.hasSection(SNAPSHOT_MEMORY)) state.mem = full.mem;
+    if (image.hasSection(SNAPSHOT_PRODCONS)) state.prodCons = full.prodCons;
+    if (image.hasSection(SNAPSHOT_HEAP)) state.heap = full.heap;
+    if (image.hasSection(SNAPSHOT_DISK)) state.disk = full.disk;
+    if (image.hasSection(SNAPSHOT_IO)) state.io = full.io;
+    if (!image.restore(state)) {
+        res.error = image.lastError();
+        return res;
+    }
+
+    int tick = state.sched ? state.sched->getTick() : 0;
+    bool diverged = false;
+    while (!in.atEnd() && !diverged) {
+        const char *opByte;
+        if (!in.bytes(1, opByte)) break;
+        TraceOp op = (TraceOp)(unsigned char)*opByte;
+        tick += (int)in.varint();
+        if (state.sched && state.sched->getTick() != tick) diverged = true;
+
+        switch (op) {
+        case TraceOp::CREATE_PROCESS: {
+            int burst = in.i32(), pages = in.i32();
+            ProcType type = (ProcType)in.varint();
+            int pid = in.i32();
+            diverged |= !state.sched || state.sched->createProcess(burst, pages, type) != pid;
+            break;
+        }
+        case TraceOp::KILL_PROCESS: {
+            int pid = in.i32();
+            bool ok = in.varint();
+            diverged |= !state.sched || state.sched->killProcess(pid) != ok;
+            break;
+        }
+        case TraceOp::SUSPEND_PROCESS: {
+            int pid = in.i32();
+            bool ok = in.varint();
+            diverged |= !state.sched || state.sched->suspendProcess(pid) != ok;
+            break;
+        }
+        case TraceOp::RESUME_PROCESS: {
+            int pid = in.i32();
+            bool ok = in.varint();
+            diverged |= !state.sched || state.sched->resumeProcess(pid) != ok;
+            break;
+        }
+        case TraceOp::CREATE_THREAD: {
+            int pid = in.i32(), burst = in.i32(), tid = in.i32();
+            diverged |= !state.sched || state.sched->createThreadInProcess(pid, burst) != tid;
+            break;
+        }
+        case TraceOp::SET_PRIORITY: {
+            int pid = in.i32(), nice = in.i32();
+            bool ok = in.varint();
+            diverged |= !state.sched || state.sched->setPriority(pid, nice) != ok;
+            break;
+        }
+        case TraceOp::TICK:
+            if (state.sched) state.sched->tick();
+            else diverged = true;
+            break;
+        case TraceOp::RUN_TICKS: {
+            int n = in.i32();
+            if (state.sched) state.sched->runTicks(n);
+            else diverged = true;
+            break;
+        }
+        case TraceOp::HEAP_ALLOC: {
+            size_t size = in.varint(), addr = in.varint();
+            void *ptr = state.heap ? state.heap->allocate(size) : nullptr;
+            diverged |= !state.heap || (ptr ? reinterpret_cast<size_t>(ptr) + 1 : 0) != addr;
+            break;
+        }
+        case TraceOp::HEAP_FREE: {
+            size_t addr = in.varint();
+            bool ok = in.varint();
+            diverged |= !state.heap || state.heap->deallocate(reinterpret_cast<void *>(addr)) != ok;
+            break;
+        }
+        case TraceOp::DISK_REQUEST: {
+            int cylinder = in.i32();
+            if (state.disk) state.disk->addRequest(cylinder);
+            else diverged = true;
+            break;
+        }
+        case TraceOp::DISK_PROCESS: {
+            int cylinder = in.i32();
+            diverged |= !state.disk || state.disk->processNext() != cylinder;
+            break;
+        }
+        case TraceOp::IO_REQUEST: {
+            int pid = in.i32(), priority = in.i32();
+            const char *dev;
+            size_t len = in.varint();
+            if (!in.bytes(len, dev)) break;
+            int duration = in.i32();
+            if (state.io) state.io->addIORequest(pid, priority, std::string(dev, len), duration);
+            else diverged = true;
+            break;
+        }
+        case TraceOp::IO_TICK: {
+            bool assigned = in.varint();
+            diverged |= !state.io || state.io->processIOTick() != assigned;
+            break;
+        }
+        case TraceOp::SET_FRAMES: {
+            int n = in.i32();
+            if (state.mem) state.mem->setNumFrames(n);
+            else diverged = true;
+            break;
+        }
+        case TraceOp::SET_PAGE_ALGO: {
+            uint64_t algo = in.varint();
+            if (state.mem && algo < (uint64_t)PAGE_ALGO_COUNT) state.mem->setAlgorithm((PageAlgo)algo);
+            else diverged = true;
+            break;
+        }
+        case TraceOp::SET_PFF_PARAMS: {
+            int high = in.i32(), low = in.i32(), window = in.i32();
+            if (state.mem) state.mem->setPFFParams(high, low, window);
+            else diverged = true;
+            break;
+        }
+        case TraceOp::SET_WS_WINDOW: {
+            int tau = in.i32();
+            if (state.mem) state.mem->setWorkingSetWindow(tau);
+            else diverged = true;
+            break;
+        }
+        case TraceOp::SCHEDULE_PROCESS: {
+            int arrival = in.i32(), burst = in.i32(), pages = in.i32();
+            ProcType type = (ProcType)in.varint();
+            int pid = in.i32();
+            diverged |= !state.sched ||
+                        state.sched->scheduleProcess(arrival, burst, pages, type) != pid;
+            break;
+        }
+        case TraceOp::CREATE_PERIODIC: {
+            int wcet = in.i32(), period = in.i32(), deadline = in.i32(), pages = in.i32();
+            int pid = in.i32();
+            diverged |= !state.sched ||
+                        state.sched->createPeriodicTask(wcet, period, deadline, pages) != pid;
+            break;
+        }
+        case TraceOp::SLEEP_PROCESS: {
+            int pid = in.i32(), ticks = in.i32();
+            bool ok = in.varint();
+            diverged |= !state.sched || state.sched->sleepProcess(pid, ticks) != ok;
+            break;
+        }
+        case TraceOp::SET_WAIT_TIMEOUT: {
+            int ticks = in.i32();
+            if (state.sched) state.sched->setWaitTimeout(ticks);
+            else diverged = true;
+            break;
+        }
+        case TraceOp::SET_ACCESS_MODEL: {
+            AccessModel model = (AccessModel)in.varint();
+            uint64_t seed = in.varint();
+            AccessParams params;
+            params.wsPages = in.i32();
+            params.phaseLength = in.i32();
+            params.zipfSkew = in.i32();
+            params.loopPages = in.i32();
+            params.loopIterations = in.i32();
+            params.stride = in.i32();
+            params.writePercent = in.i32();
+            if (state.sched && (int)model < ACCESS_MODEL_COUNT)
+                state.sched->setAccessModel(model, params, seed);
+            else diverged = true;
+            break;
+        }
+        case TraceOp::SET_PROCESS_ACCESS: {
+            int pid = in.i32();
+            AccessModel model = (AccessModel)in.varint();
+            bool ok = in.varint();
+            diverged |= !state.sched || (int)model >= ACCESS_MODEL_COUNT ||
+                        state.sched->setProcessAccessModel(pid, model) != ok;
+            break;
+        }
+        case TraceOp::END: {
+            long long recorded;
+            in.fixed(res.recordedHash);
+            recorded = in.varint();
+            res.complete = in.ok() && recorded == res.events;
+            break;
+        }
+        default:
+            res.error = "código de operación desconocido";
+            return res;
+        }
+        if (!in.ok()) break;
+        if (op == TraceOp::END) break;
+        if (diverged) res.divergedAt = res.events;
+        res.events++;
+    }
+
+    res.finalTick = state.sched ? state.sched->getTick() : 0;
+    res.replayHash = stateHash(state);
+    res.elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - t0).count();
+
+    if (!in.ok()) res.error = "registro truncado";
+    else if (diverged) res.error = "la reproducción divergió de la traza";
+    else if (!res.complete) res.error = "traza sin registro final (grabación interrumpida)";
+    else if (res.replayHash != res.recordedHash) res.error = "el hash del estado final no coincide";
+    res.ok = res.error.empty();
+    return res;
+}
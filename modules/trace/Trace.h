@@ -0,0 +1,148 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include "../snapshot/Snapshot.h"
+#include "../cpu/SchedulerPolicy.h"
+
+// ========== EVENTOS DE LA TRAZA ==========
+// Toda entrada externa al simulador; cada registro guarda también el
+// resultado observado (PID, TID, dirección...) para detectar divergencias.
+enum class TraceOp : uint8_t {
+    CREATE_PROCESS = 1,     // burst, páginas, tipo -> PID
+    KILL_PROCESS,           // pid -> ok
+    SUSPEND_PROCESS,        // pid -> ok
+    RESUME_PROCESS,         // pid -> ok
+    CREATE_THREAD,          // pid, burst -> TID
+    SET_PRIORITY,           // pid, nice -> ok
+    TICK,
+    RUN_TICKS,              // n
+    HEAP_ALLOC,             // tamaño -> dirección + 1 (0 = sin memoria)
+    HEAP_FREE,              // dirección -> ok
+    DISK_REQUEST,           // cilindro
+    DISK_PROCESS,           // -> cilindro atendido
+    IO_REQUEST,             // pid, prioridad, dispositivo, duración
+    IO_TICK,                // -> hubo asignación
+    SET_FRAMES,             // marcos
+    SET_PAGE_ALGO,          // algoritmo
+    SCHEDULE_PROCESS,       // llegada, burst, páginas, tipo -> PID
+    SLEEP_PROCESS,          // pid, ticks -> ok
+    SET_WAIT_TIMEOUT,       // ticks
+    SET_ACCESS_MODEL,       // modelo, semilla, parámetros
+    SET_PROCESS_ACCESS,     // pid, modelo -> ok
+    SET_PFF_PARAMS,         // umbral alto, umbral bajo, ventana
+    SET_WS_WINDOW,          // τ
+    CREATE_PERIODIC,        // wcet, período, plazo, páginas -> PID
+    END = 0xFF              // hash del estado final + cantidad de eventos
+};
+
+const uint32_t TRACE_VERSION = 4;      // 4: tareas periódicas (EDF/RM)
+
+// Hash FNV-1a de 64 bits sobre la serialización de snapshot del estado
+uint64_t stateHash(const SimState &state);
+
+// ========== GRABADOR ==========
+/**
+ * Fachada de las entradas externas: cada método aplica la operación sobre
+ * el estado enlazado y, si hay una grabación activa, la anota en el log.
+ * - Encabezado: "KTRC", versión, política y un snapshot del estado inicial,
+ *   así la reproducción no necesita el CLI ni la configuración previa.
+ * - Registros: código de operación, ticks desde el registro anterior y
+ *   argumentos en varint (zigzag para los que pueden ser negativos).
+ * - Solo se agrega al final del archivo; stop() cierra con el hash del
+ *   estado final.
+ */
+class TraceRecorder {
+private:
+    SimState state;
+    std::ofstream out;
+    std::vector<char> pending;          // Registros aún no escritos
+    bool recording;
+    int lastTick;
+    long long events;
+
+    void begin(TraceOp op);
+    void flushPending();
+
+public:
+    TraceRecorder();
+    ~TraceRecorder();
+
+    // Estado sobre el que actúan las operaciones (se re-enlaza al cambiarlo)
+    void bind(const SimState &s);
+
+    bool start(const std::string &path, SchedPolicy policy, std::string *error = nullptr);
+    bool stop();
+    bool isRecording() const;
+    long long getEventCount() const;
+
+    // Operaciones (siempre se aplican; se anotan sólo si recording)
+    int createProcess(int burst, int pages = 4, ProcType type = ProcType::NORMAL);
+    bool killProcess(int pid);
+    bool suspendProcess(int pid);
+    bool resumeProcess(int pid);
+    int createThreadInProcess(int pid, int burst);
+    bool setPriority(int pid, int nice);
+    int scheduleProcess(int arrivalTick, int burst, int pages = 4, ProcType type = ProcType::NORMAL);
+    int createPeriodicTask(int wcet, int period, int deadline = 0, int pages = 4);
+    bool sleepProcess(int pid, int ticks);
+    void setWaitTimeout(int ticks);
+    void setAccessModel(AccessModel model, const AccessParams &params, uint64_t seed);
+    bool setProcessAccessModel(int pid, AccessModel model);
+    void tick();
+    void runTicks(int n);
+    void *heapAllocate(size_t size);
+    bool heapFree(void *ptr);
+    void diskRequest(int cylinder);
+    int diskProcessNext();
+    void ioRequest(int pid, int priority, const std::string &device, int duration);
+    bool ioTick();
+    void setNumFrames(int n);
+    void setPageAlgorithm(PageAlgo algo);
+    void setPFFParams(int high, int low, int window);
+    void setWorkingSetWindow(int tau);
+};
+
+// ========== REPRODUCCIÓN ==========
+struct TraceReplayResult {
+    bool ok;                    // Sin divergencias y hash final coincidente
+    bool complete;              // La traza terminó con su registro END
+    long long events;           // Eventos aplicados
+    long long divergedAt;       // Índice del evento divergente (-1 = ninguno)
+    int finalTick;
+    uint64_t recordedHash;
+    uint64_t replayHash;
+    double elapsedMs;
+    std::string error;
+
+    TraceReplayResult();
+};
+
+/**
+ * Reproduce una traza sin el CLI: mapea el archivo, crea los módulos de la
+ * política grabada, restaura el snapshot inicial y aplica los eventos en
+ * orden. Cada evento verifica el tick y el resultado grabados; al final se
+ * compara el hash del estado.
+ */
+class TraceReplayer {
+private:
+    MemoryManager mem;
+    ProducerConsumer prodCons;
+    SchedulerCore *sched;
+    HeapAllocator heap;
+    DiskScheduler disk;
+    IOManager io;
+
+public:
+    TraceReplayer();
+    ~TraceReplayer();
+
+    TraceReplayResult replay(const std::string &path);
+    // Estado al terminar la reproducción (para inspeccionarlo o seguir)
+    SimState getState();
+};
+
+#endif // TRACE_H
@@ -0,0 +1,73 @@
+#ifndef VARINT_H
+#define VARINT_H
+
+#include <vector>
+#include <cstring>
+#include <cstdint>
+
+// ========== CODIFICACIÓN VARINT ==========
+
+inline void putVarint(std::vector<char> &buf, uint64_t v) {
+    while (v >= 0x80) {
+        buf.push_back((char)(v | 0x80));
+        v >>= 7;
+    }
+    buf.push_back((char)v);
+}
+
+// Zigzag: enteros pequeños (también negativos) en pocos bytes
+inline void putSigned(std::vector<char> &buf, long long v) {
+    putVarint(buf, ((uint64_t)v << 1) ^ (uint64_t)(v >> 63));
+}
+
+// Lectura acotada sobre memoria mapeada: un varint truncado invalida el cursor
+class TraceCursor {
+private:
+    const unsigned char *cur;
+    const unsigned char *end;
+    bool valid;
+
+public:
+    TraceCursor(const char *data, size_t n)
+        : cur((const unsigned char *)data), end((const unsigned char *)data + n), valid(true) {}
+
+    uint64_t varint() {
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (cur == end) break;
+            unsigned char b = *cur++;
+            v |= (uint64_t)(b & 0x7F) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        valid = false;
+        return 0;
+    }
+
+    long long sgn() {
+        uint64_t z = varint();
+        return (long long)(z >> 1) ^ -(long long)(z & 1);
+    }
+
+    int i32() { return (int)sgn(); }
+
+    bool bytes(size_t n, const char *&out) {
+        if ((size_t)(end - cur) < n) return valid = false;
+        out = (const char *)cur;
+        cur += n;
+        return true;
+    }
+
+    template <class T>
+    bool fixed(T &v) {
+        const char *p;
+        if (!bytes(sizeof(T), p)) return false;
+        std::memcpy(&v, p, sizeof(T));
+        return true;
+    }
+
+    bool ok() const { return valid; }
+    const char *position() const { return (const char *)cur; }
+    bool atEnd() const { return cur == end; }
+};
+
+#endif // VARINT_H
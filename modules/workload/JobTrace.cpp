@@ -0,0 +1,405 @@
+#include "JobTrace.h"
+#include "WorkloadGenerator.h"
+#include "../trace/Varint.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <climits>
+#include <chrono>
+#include <cctype>
+#include <cstring>
+
+static const char JOB_TRACE_MAGIC[4] = {'K', 'J', 'O', 'B'};
+static const size_t JOB_TRACE_HEADER_SIZE = 4 + sizeof(uint32_t);
+static const size_t JOB_TRACE_FLUSH_BYTES = 1 << 16;
+
+const char *const JOB_TRACE_DEVICE_NAMES[JOB_TRACE_DEVICES] = {"PRINTER", "DISK", "NETWORK"};
+
+// ========== CAMPOS CSV ==========
+
+static bool isBlank(char c) { return c == ' ' || c == '\t'; }
+
+// Separa el próximo campo [start, stop) y deja p después de la coma
+static bool nextField(const char *&p, const char *eol, const char *&start, const char *&stop) {
+    while (p < eol && isBlank(*p)) p++;
+    if (p >= eol) return false;
+    start = p;
+    while (p < eol && *p != ',') p++;
+    stop = p;
+    while (stop > start && isBlank(stop[-1])) stop--;
+    if (p < eol) p++;
+    return stop > start;
+}
+
+static bool parseInt(const char *start, const char *stop, long long &v) {
+    bool neg = *start == '-';
+    if (neg || *start == '+') start++;
+    if (start == stop) return false;
+    v = 0;
+    for (; start < stop; start++) {
+        if (*start < '0' || *start > '9') return false;
+        v = v * 10 + (*start - '0');
+        if (v > INT_MAX) return false;
+    }
+    if (neg) v = -v;
+    return true;
+}
+
+static bool intField(const char *&p, const char *eol, long long &v) {
+    const char *start, *stop;
+    return nextField(p, eol, start, stop) && parseInt(start, stop, v);
+}
+
+static bool sameWord(const char *start, const char *stop, const char *word) {
+    size_t n = std::strlen(word);
+    if ((size_t)(stop - start) != n) return false;
+    for (size_t i = 0; i < n; i++)
+        if (std::toupper((unsigned char)start[i]) != word[i]) return false;
+    return true;
+}
+
+// ========== LECTOR ==========
+
+JobTraceReader::JobTraceReader()
+    : cur(nullptr), end(nullptr), binary(false), started(false), line(0), jobs(0),
+      lastTick(0), released(0) {}
+
+bool JobTraceReader::fail(const std::string &msg) {
+    error = binary ? msg : "línea " + std::to_string(line) + ": " + msg;
+    cur = end;
+    return false;
+}
+
+bool JobTraceReader::open(const std::string &path) {
+    error.clear();
+    started = false;
+    line = jobs = 0;
+    lastTick = 0;
+    released = 0;
+    if (!file.open(path)) {
+        cur = end = nullptr;
+        error = "no se pudo abrir " + path;
+        return false;
+    }
+    file.adviseSequential();
+    cur = file.bytes();
+    end = cur + file.size();
+
+    binary = file.size() >= 4 && std::memcmp(cur, JOB_TRACE_MAGIC, 4) == 0;
+    if (binary) {
+        uint32_t version = 0;
+        if (file.size() >= JOB_TRACE_HEADER_SIZE) std::memcpy(&version, cur + 4, sizeof(version));
+        if (version != JOB_TRACE_VERSION) {
+            cur = end;
+            error = "versión de traza no soportada";
+            return false;
+        }
+        cur += JOB_TRACE_HEADER_SIZE;
+    }
+    return true;
+}
+
+bool JobTraceReader::next(JobRecord &rec) {
+    if (cur >= end) return false;
+    bool ok = binary ? nextBinary(rec) : nextCSV(rec);
+
+    // Descartar lo ya consumido para no retener la traza completa
+    size_t at = offset();
+    if (at - released >= RELEASE_BYTES) {
+        file.release(at);
+        released = at;
+    }
+    return ok;
+}
+
+bool JobTraceReader::nextBinary(JobRecord &rec) {
+    TraceCursor in(cur, end - cur);
+    const char *opByte;
+    if (!in.bytes(1, opByte)) return false;
+    rec.kind = (JobRecordKind)(unsigned char)*opByte;
+    long long tick = lastTick + in.sgn();
+
+    if (rec.kind == JobRecordKind::JOB) {
+        rec.burst = (int)in.varint();
+        rec.pages = (int)in.varint();
+        rec.type = (ProcType)in.varint();
+        rec.threads = (int)in.varint();
+        rec.threadBurst = (int)in.varint();
+        rec.job = jobs;
+    } else if (rec.kind == JobRecordKind::IO) {
+        rec.job = (long long)in.varint();
+        rec.device = (int)in.varint();
+        rec.duration = (int)in.varint();
+        rec.priority = (int)in.varint();
+    } else {
+        return fail("registro desconocido en el byte " + std::to_string(offset()));
+    }
+    if (!in.ok()) return fail("traza truncada en el byte " + std::to_string(offset()));
+    bool badField = rec.kind == JobRecordKind::IO ? rec.device >= JOB_TRACE_DEVICES
+                                                   : rec.type > ProcType::WRITER;
+    if (tick < 0 || tick > INT_MAX || badField)
+        return fail("registro inválido en el byte " + std::to_string(offset()));
+
+    cur = in.position();
+    rec.tick = lastTick = (int)tick;
+    if (rec.kind == JobRecordKind::JOB) jobs++;
+    return true;
+}
+
+bool JobTraceReader::nextCSV(JobRecord &rec) {
+    while (cur < end) {
+        const char *eol = static_cast<const char *>(std::memchr(cur, '\n', end - cur));
+        if (!eol) eol = end;
+        const char *p = cur, *stop = eol;
+        cur = eol < end ? eol + 1 : end;
+        line++;
+
+        while (stop > p && (stop[-1] == '\r' || isBlank(stop[-1]))) stop--;
+        while (p < stop && isBlank(*p)) p++;
+        if (p == stop || *p == '#') continue;
+
+        bool header = !started && !(*p >= '0' && *p <= '9') &&
+                      !(stop - p > 2 && sameWord(p, p + 2, "IO") && p[2] == ',');
+        started = true;
+        if (parseCSVLine(p, stop, rec)) {
+            lastTick = rec.tick;
+            if (rec.kind == JobRecordKind::JOB) rec.job = jobs++;
+            return true;
+        }
+        // Una primera línea no numérica es el encabezado de columnas
+        if (!header) return fail("registro inválido");
+    }
+    return false;
+}
+
+bool JobTraceReader::parseCSVLine(const char *p, const char *eol, JobRecord &rec) {
+    const char *start, *stop;
+    long long v[4];
+    const char *first = p;
+    if (!nextField(p, eol, start, stop)) return false;
+
+    if (sameWord(start, stop, "IO")) {
+        // io,tick,job,device,duration[,priority]
+        rec.kind = JobRecordKind::IO;
+        if (!intField(p, eol, v[0]) || !intField(p, eol, v[1])) return false;
+        if (!nextField(p, eol, start, stop)) return false;
+        rec.device = -1;
+        for (int d = 0; d < JOB_TRACE_DEVICES; d++)
+            if (sameWord(start, stop, JOB_TRACE_DEVICE_NAMES[d])) rec.device = d;
+        if (rec.device < 0 || !intField(p, eol, v[2])) return false;
+        v[3] = 3;
+        if (p < eol && !intField(p, eol, v[3])) return false;
+        if (v[0] < 0 || v[1] < 0) return false;
+        rec.tick = (int)v[0];
+        rec.job = v[1];
+        rec.duration = (int)v[2];
+        rec.priority = (int)v[3];
+        return p >= eol;
+    }
+
+    // arrival,burst,pages[,type[,threads[,threadBurst]]]
+    rec.kind = JobRecordKind::JOB;
+    p = first;
+    if (!intField(p, eol, v[0]) || !intField(p, eol, v[1]) || !intField(p, eol, v[2])) return false;
+    if (v[0] < 0) return false;
+    rec.tick = (int)v[0];
+    rec.burst = (int)v[1];
+    rec.pages = (int)v[2];
+    rec.type = ProcType::NORMAL;
+    rec.threads = 0;
+    rec.threadBurst = rec.burst;
+
+    if (p < eol) {
+        long long t;
+        if (!nextField(p, eol, start, stop)) return false;
+        if (sameWord(start, stop, "N")) rec.type = ProcType::NORMAL;
+        else if (sameWord(start, stop, "P")) rec.type = ProcType::PRODUCER;
+        else if (sameWord(start, stop, "C")) rec.type = ProcType::CONSUMER;
+        else if (parseInt(start, stop, t) && t >= 0 && t <= (int)ProcType::WRITER) rec.type = (ProcType)t;
+        else return false;
+    }
+    if (p < eol) {
+        if (!intField(p, eol, v[3]) || v[3] < 0) return false;
+        rec.threads = (int)v[3];
+    }
+    if (p < eol) {
+        if (!intField(p, eol, v[3])) return false;
+        rec.threadBurst = (int)v[3];
+    }
+    return p >= eol;
+}
+
+bool JobTraceReader::failed() const { return !error.empty(); }
+const std::string &JobTraceReader::lastError() const { return error; }
+bool JobTraceReader::isBinary() const { return binary; }
+size_t JobTraceReader::size() const { return file.size(); }
+size_t JobTraceReader::offset() const { return file.bytes() ? cur - file.bytes() : 0; }
+
+// ========== ESCRITOR ==========
+
+JobTraceWriter::JobTraceWriter() : lastTick(0), jobs(0) {}
+
+JobTraceWriter::~JobTraceWriter() { close(); }
+
+bool JobTraceWriter::open(const std::string &path) {
+    close();
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    out.write(JOB_TRACE_MAGIC, 4);
+    out.write(reinterpret_cast<const char *>(&JOB_TRACE_VERSION), sizeof(JOB_TRACE_VERSION));
+    lastTick = 0;
+    jobs = 0;
+    return (bool)out;
+}
+
+void JobTraceWriter::add(const JobRecord &rec) {
+    pending.push_back((char)rec.kind);
+    putSigned(pending, (long long)rec.tick - lastTick);
+    lastTick = rec.tick;
+    if (rec.kind == JobRecordKind::JOB) {
+        putVarint(pending, std::max(rec.burst, 0));
+        putVarint(pending, std::max(rec.pages, 0));
+        putVarint(pending, (uint64_t)rec.type);
+        putVarint(pending, std::max(rec.threads, 0));
+        putVarint(pending, std::max(rec.threadBurst, 0));
+        jobs++;
+    } else {
+        putVarint(pending, std::max(rec.job, 0LL));
+        putVarint(pending, std::max(rec.device, 0));
+        putVarint(pending, std::max(rec.duration, 0));
+        putVarint(pending, std::max(rec.priority, 0));
+    }
+    if (pending.size() >= JOB_TRACE_FLUSH_BYTES) flushPending();
+}
+
+void JobTraceWriter::flushPending() {
+    out.write(pending.data(), pending.size());
+    pending.clear();
+}
+
+bool JobTraceWriter::close() {
+    if (!out.is_open()) return false;
+    flushPending();
+    bool ok = (bool)out;
+    out.close();
+    return ok;
+}
+
+bool convertJobTrace(const std::string &from, const std::string &to, std::string *error) {
+    JobTraceReader reader;
+    JobTraceWriter writer;
+    if (!reader.open(from)) {
+        if (error) *error = reader.lastError();
+        return false;
+    }
+    if (!writer.open(to)) {
+        if (error) *error = "no se pudo crear " + to;
+        return false;
+    }
+    JobRecord rec;
+    while (reader.next(rec)) writer.add(rec);
+    bool written = writer.close();
+    if (reader.failed() || !written) {
+        if (error) *error = reader.failed() ? reader.lastError() : "error de escritura en " + to;
+        return false;
+    }
+    return true;
+}
+
+// ========== INYECCIÓN ==========
+
+JobTraceInjector::JobTraceInjector()
+    : hasAhead(false), base(-1),
+      windowJob(PID_WINDOW, -1), windowPid(PID_WINDOW, -1), stats() {}
+
+bool JobTraceInjector::open(const std::string &path, std::string *error) {
+    stats = JobTraceStats();
+    base = -1;
+    std::fill(windowJob.begin(), windowJob.end(), -1);
+    hasAhead = reader.open(path) && reader.next(ahead);
+    if (reader.failed()) {
+        if (error) *error = reader.lastError();
+        return false;
+    }
+    return true;
+}
+
+bool JobTraceInjector::done() const { return !hasAhead; }
+
+int JobTraceInjector::nextArrival() const {
+    if (!hasAhead) return INT_MAX;
+    long long at = (long long)std::max(base, 0) + ahead.tick;
+    return at > INT_MAX ? INT_MAX : (int)at;
+}
+
+void JobTraceInjector::inject(const JobRecord &rec, SchedulerCore &sched, IOManager *io) {
+    if (rec.kind == JobRecordKind::JOB) {
+        int pid = sched.createProcess(std::max(rec.burst, 1), std::max(rec.pages, 1), rec.type);
+        for (int i = 0; i < rec.threads; i++)
+            if (sched.createThreadInProcess(pid, std::max(rec.threadBurst, 1)) != -1) stats.threads++;
+        int slot = (int)(rec.job % PID_WINDOW);
+        windowJob[slot] = rec.job;
+        windowPid[slot] = pid;
+        stats.jobs++;
+        stats.lastArrival = sched.getTick();
+        return;
+    }
+
+    int slot = (int)(rec.job % PID_WINDOW);
+    if (!io || windowJob[slot] != rec.job) {
+        stats.ioDropped++;
+        return;
+    }
+    io->addIORequest(windowPid[slot], std::min(std::max(rec.priority, 1), 5),
+                     JOB_TRACE_DEVICE_NAMES[rec.device], std::max(rec.duration, 1));
+    stats.ioEvents++;
+}
+
+long long JobTraceInjector::pump(SchedulerCore &sched, IOManager *io) {
+    if (base < 0) base = sched.getTick();
+    long long applied = 0;
+    while (hasAhead && nextArrival() <= sched.getTick()) {
+        int tick = ahead.tick;
+        inject(ahead, sched, io);
+        applied++;
+        hasAhead = reader.next(ahead);
+        if (hasAhead && ahead.tick < tick) stats.late++;
+    }
+    stats.bytes = reader.offset();
+    return applied;
+}
+
+JobTraceStats JobTraceInjector::run(SchedulerCore &sched, IOManager *io, int reapInterval) {
+    auto start = std::chrono::steady_clock::now();
+    if (base < 0) base = sched.getTick();
+    int nextReap = reapInterval > 0 ? sched.getTick() + reapInterval : INT_MAX;
+
+    while (hasAhead) {
+        stats.reaped += advanceWithReap(sched, nextArrival(), reapInterval, nextReap);
+        pump(sched, io);
+    }
+
+    stats.elapsedMs += std::chrono::duration<double, std::milli>(
+                           std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+const JobTraceStats &JobTraceInjector::getStats() const { return stats; }
+const std::string &JobTraceInjector::lastError() const { return reader.lastError(); }
+
+void JobTraceInjector::showStats(const JobTraceStats &st) {
+    std::cout << "\n┌──────────────────────────────────────────┐\n";
+    std::cout << "│          TRAZA DE TRABAJOS CARGADA       │\n";
+    std::cout << "├──────────────────────────────────────────┤\n";
+    std::cout << "│ Trabajos inyectados:" << std::setw(20) << st.jobs << " │\n";
+    std::cout << "│ Hilos creados:      " << std::setw(20) << st.threads << " │\n";
+    std::cout << "│ Solicitudes de E/S: " << std::setw(20) << st.ioEvents << " │\n";
+    std::cout << "│ E/S descartadas:    " << std::setw(20) << st.ioDropped << " │\n";
+    std::cout << "│ Registros atrasados:" << std::setw(20) << st.late << " │\n";
+    std::cout << "│ Slots liberados:    " << std::setw(20) << st.reaped << " │\n";
+    std::cout << "│ Última llegada:     " << std::setw(20) << st.lastArrival << " │\n";
+    std::cout << "│ Bytes leídos:       " << std::setw(20) << st.bytes << " │\n";
+    std::cout << "│ Tiempo real (ms):   " << std::setw(20) << std::fixed << std::setprecision(1)
+              << st.elapsedMs << " │\n";
+    std::cout << "└──────────────────────────────────────────┘\n";
+}
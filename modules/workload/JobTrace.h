@@ -0,0 +1,163 @@
+#ifndef JOB_TRACE_H
+#define JOB_TRACE_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include "../cpu/Scheduler.h"
+#include "../io/IOManager.h"
+#include "../snapshot/Snapshot.h"
+
+// ========== FORMATO ==========
+// CSV (una entrada por línea, ordenadas por tick; '#' inicia un comentario):
+//   arrival,burst,pages[,type[,threads[,threadBurst]]]     type: N/P/C o el número de ProcType
+//   io,tick,job,device,duration[,priority]                 job: índice del trabajo
+// Binario: "KJOB", versión y registros en varint con el tick relativo al
+// registro anterior (ver JOB_TRACE_README.md).
+const uint32_t JOB_TRACE_VERSION = 1;
+
+enum class JobRecordKind : uint8_t {
+    JOB = 1,
+    IO = 2
+};
+
+// Dispositivos del IOManager, por índice en la traza
+const int JOB_TRACE_DEVICES = 3;
+extern const char *const JOB_TRACE_DEVICE_NAMES[JOB_TRACE_DEVICES];
+
+// ========== REGISTRO ==========
+struct JobRecord {
+    JobRecordKind kind;
+    int tick;                   // Relativo al inicio de la traza
+    // JOB
+    int burst;
+    int pages;
+    ProcType type;
+    int threads;
+    int threadBurst;
+    // IO
+    long long job;              // Índice (0..n-1) del trabajo que la pide
+    int device;
+    int duration;
+    int priority;
+};
+
+// ========== LECTOR ==========
+/**
+ * Lee una traza de trabajos mapeada en memoria, un registro por llamada.
+ * - Detecta el formato por la firma: "KJOB" es binario, lo demás CSV.
+ * - El CSV se interpreta directamente sobre el mapeo (sin streams ni
+ *   copias por línea); una primera línea no numérica se toma como
+ *   encabezado.
+ * - Memoria constante: las páginas ya consumidas se descartan del mapeo
+ *   cada RELEASE_BYTES, así una traza mayor que la RAM no queda residente.
+ */
+class JobTraceReader {
+private:
+    static const size_t RELEASE_BYTES = 64u << 20;
+
+    MappedFile file;
+    const char *cur;
+    const char *end;
+    bool binary;
+    bool started;               // CSV: ya hubo una línea con datos
+    long long line;             // CSV: línea actual (para los errores)
+    long long jobs;             // Trabajos leídos (índice del próximo)
+    int lastTick;
+    size_t released;
+    std::string error;
+
+    bool fail(const std::string &msg);
+    bool nextBinary(JobRecord &rec);
+    bool nextCSV(JobRecord &rec);
+    bool parseCSVLine(const char *p, const char *eol, JobRecord &rec);
+
+public:
+    JobTraceReader();
+
+    bool open(const std::string &path);
+    // false al terminar la traza o ante un registro inválido (ver failed())
+    bool next(JobRecord &rec);
+    bool failed() const;
+    const std::string &lastError() const;
+    bool isBinary() const;
+    size_t size() const;
+    size_t offset() const;
+};
+
+// ========== ESCRITOR BINARIO ==========
+class JobTraceWriter {
+private:
+    std::ofstream out;
+    std::vector<char> pending;
+    int lastTick;
+    long long jobs;
+
+    void flushPending();
+
+public:
+    JobTraceWriter();
+    ~JobTraceWriter();
+
+    bool open(const std::string &path);
+    void add(const JobRecord &rec);
+    bool close();
+};
+
+// Reescribe una traza (CSV o binaria) en el formato binario compacto
+bool convertJobTrace(const std::string &from, const std::string &to,
+                     std::string *error = nullptr);
+
+// ========== INYECCIÓN EN EL PLANIFICADOR ==========
+struct JobTraceStats {
+    long long jobs;
+    long long threads;
+    long long ioEvents;
+    long long ioDropped;        // Sin IOManager o trabajo fuera de la ventana
+    long long late;             // Registros con tick menor al anterior
+    long long reaped;
+    int lastArrival;
+    size_t bytes;
+    double elapsedMs;
+};
+
+/**
+ * Inyecta los trabajos de una traza a medida que el reloj del planificador
+ * alcanza su llegada. Sólo mantiene un registro adelantado y una ventana
+ * circular de PIDs para resolver las E/S (que referencian trabajos por su
+ * índice en la traza), por lo que la memoria no depende del largo.
+ * Los ticks de la traza se cuentan desde el primer pump()/run().
+ */
+class JobTraceInjector {
+private:
+    static const int PID_WINDOW = 1 << 16;
+
+    JobTraceReader reader;
+    JobRecord ahead;
+    bool hasAhead;
+    int base;
+    std::vector<long long> windowJob;
+    std::vector<int> windowPid;
+    JobTraceStats stats;
+
+    void inject(const JobRecord &rec, SchedulerCore &sched, IOManager *io);
+
+public:
+    JobTraceInjector();
+
+    bool open(const std::string &path, std::string *error = nullptr);
+    bool done() const;
+    // Tick absoluto del planificador en que llega el próximo registro
+    int nextArrival() const;
+    // Inyecta todo lo que ya llegó; devuelve los registros aplicados
+    long long pump(SchedulerCore &sched, IOManager *io = nullptr);
+    // Avanza el planificador hasta agotar la traza
+    JobTraceStats run(SchedulerCore &sched, IOManager *io = nullptr, int reapInterval = 0);
+
+    const JobTraceStats &getStats() const;
+    const std::string &lastError() const;
+    static void showStats(const JobTraceStats &stats);
+};
+
+#endif // JOB_TRACE_H
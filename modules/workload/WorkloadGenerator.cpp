@@ -0,0 +1,201 @@
+#include "WorkloadGenerator.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <climits>
+#include <chrono>
+#include <cmath>
+
+static const double PI = 3.14159265358979323846;
+
+WorkloadConfig::WorkloadConfig()
+    : seed(1), numProcs(1000),
+      arrival(ArrivalModel::POISSON), arrivalRate(0.5),
+      burstFactor(8), burstOnTicks(20), burstOffTicks(80),
+      diurnalPeriod(1000), diurnalAmplitude(0.8),
+      burst(BurstModel::EXPONENTIAL), meanBurst(8), paretoAlpha(1.5),
+      bimodalShort(3), bimodalLong(40), bimodalLongFraction(0.1), maxBurst(10000),
+      minPages(1), maxPages(8),
+      threadedFraction(0.1), maxThreads(4), meanThreadBurst(4),
+      producerFraction(0.05), consumerFraction(0.05),
+      reapInterval(0) {}
+
+WorkloadGenerator::WorkloadGenerator(const WorkloadConfig &config) : cfg(config) { reset(); }
+
+void WorkloadGenerator::reset() {
+    rng.seed(cfg.seed);
+    clock = 0;
+    burstOn = false;
+    phaseEnd = 0;
+    generated = 0;
+}
+
+// ========== MUESTREO ==========
+
+// Uniforme en (0, 1]: 53 bits de la salida, nunca 0 (log/pow seguros)
+double WorkloadGenerator::uniform() {
+    return ((rng() >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+double WorkloadGenerator::exponential(double mean) {
+    return -mean * std::log(uniform());
+}
+
+double WorkloadGenerator::nextArrivalTime() {
+    double rate = std::max(cfg.arrivalRate, 1e-9);
+    switch (cfg.arrival) {
+    case ArrivalModel::POISSON:
+        clock += exponential(1.0 / rate);
+        break;
+
+    case ArrivalModel::BURSTY: {
+        // Proceso de Poisson modulado por una cadena on/off: al cruzar el fin
+        // de una fase se cambia de estado y se vuelve a muestrear (sin memoria)
+        while (true) {
+            double stateRate = burstOn ? rate * cfg.burstFactor : rate / cfg.burstFactor;
+            double t = clock + exponential(1.0 / stateRate);
+            if (t <= phaseEnd) {
+                clock = t;
+                break;
+            }
+            clock = phaseEnd;
+            burstOn = !burstOn;
+            phaseEnd = clock + exponential(burstOn ? cfg.burstOnTicks : cfg.burstOffTicks);
+        }
+        break;
+    }
+
+    case ArrivalModel::DIURNAL: {
+        // Thinning: candidatos a la tasa máxima, aceptados con λ(t) / λmax
+        double amp = std::min(std::max(cfg.diurnalAmplitude, 0.0), 1.0);
+        double maxRate = rate * (1 + amp);
+        do {
+            clock += exponential(1.0 / maxRate);
+        } while (uniform() * (1 + amp) > 1 + amp * std::sin(2 * PI * clock / cfg.diurnalPeriod));
+        break;
+    }
+    }
+    return clock;
+}
+
+int WorkloadGenerator::sampleBurst() {
+    double x;
+    switch (cfg.burst) {
+    case BurstModel::PARETO: {
+        // Escala tal que la media sea meanBurst: xm = media (α - 1) / α
+        double alpha = std::max(cfg.paretoAlpha, 1.01);
+        double xm = cfg.meanBurst * (alpha - 1) / alpha;
+        x = xm / std::pow(uniform(), 1.0 / alpha);
+        break;
+    }
+    case BurstModel::BIMODAL:
+        x = exponential(uniform() <= cfg.bimodalLongFraction ? cfg.bimodalLong : cfg.bimodalShort);
+        break;
+    default:
+        x = exponential(cfg.meanBurst);
+        break;
+    }
+    return (int)std::min<double>(std::max(1.0, std::round(x)), cfg.maxBurst);
+}
+
+int WorkloadGenerator::nextThreadBurst() {
+    return (int)std::min<double>(std::max(1.0, std::round(exponential(cfg.meanThreadBurst))),
+                                 cfg.maxBurst);
+}
+
+bool WorkloadGenerator::next(GeneratedProcess &p) {
+    if (generated >= cfg.numProcs) return false;
+    generated++;
+
+    double t = nextArrivalTime();
+    p.arrivalTick = t >= INT_MAX ? INT_MAX : (int)t;
+    p.burst = sampleBurst();
+    int span = std::max(1, cfg.maxPages - cfg.minPages + 1);
+    p.pages = cfg.minPages + (int)(rng() % span);
+
+    double roll = uniform();
+    p.type = roll <= cfg.producerFraction ? ProcType::PRODUCER
+           : roll <= cfg.producerFraction + cfg.consumerFraction ? ProcType::CONSUMER
+           : ProcType::NORMAL;
+    p.threads = 0;
+    if (cfg.maxThreads > 0 && uniform() <= cfg.threadedFraction)
+        p.threads = 1 + (int)(rng() % cfg.maxThreads);
+    return true;
+}
+
+// ========== CORRIDA SOBRE UN PLANIFICADOR ==========
+
+WorkloadStats WorkloadGenerator::run(SchedulerCore &sched) {
+    auto start = std::chrono::steady_clock::now();
+    WorkloadStats st = {};
+    int base = sched.getTick();
+    int nextReap = cfg.reapInterval > 0 ? base + cfg.reapInterval : INT_MAX;
+
+    GeneratedProcess p;
+    while (next(p)) {
+        int arrival = base + p.arrivalTick;
+        st.reaped += advanceWithReap(sched, arrival, cfg.reapInterval, nextReap);
+
+        int pid = sched.createProcess(p.burst, p.pages, p.type);
+        for (int i = 0; i < p.threads; i++)
+            if (sched.createThreadInProcess(pid, nextThreadBurst()) != -1) st.threads++;
+
+        st.created++;
+        st.totalBurst += p.burst;
+        if (p.type == ProcType::PRODUCER) st.producers++;
+        else if (p.type == ProcType::CONSUMER) st.consumers++;
+        st.lastArrival = arrival;
+    }
+
+    st.elapsedMs = std::chrono::duration<double, std::milli>(
+                       std::chrono::steady_clock::now() - start).count();
+    return st;
+}
+
+long long advanceWithReap(SchedulerCore &sched, int tick, int reapInterval, int &nextReap) {
+    long long reaped = 0;
+    while (sched.getTick() < tick) {
+        int until = reapInterval > 0 ? std::min(tick, nextReap) : tick;
+        if (until > sched.getTick()) sched.runTicks(until - sched.getTick());
+        if (reapInterval > 0 && sched.getTick() >= nextReap) {
+            reaped += sched.reapTerminated();
+            nextReap += reapInterval;
+        }
+    }
+    return reaped;
+}
+
+void WorkloadGenerator::showStats(const WorkloadStats &st) {
+    std::cout << "\n┌──────────────────────────────────────────┐\n";
+    std::cout << "│          CARGA SINTÉTICA GENERADA        │\n";
+    std::cout << "├──────────────────────────────────────────┤\n";
+    std::cout << "│ Procesos creados:   " << std::setw(20) << st.created << " │\n";
+    std::cout << "│ Hilos creados:      " << std::setw(20) << st.threads << " │\n";
+    std::cout << "│ Productores:        " << std::setw(20) << st.producers << " │\n";
+    std::cout << "│ Consumidores:       " << std::setw(20) << st.consumers << " │\n";
+    std::cout << "│ Ráfaga media:       " << std::setw(20) << std::fixed << std::setprecision(2)
+              << (st.created ? (double)st.totalBurst / st.created : 0.0) << " │\n";
+    std::cout << "│ Última llegada:     " << std::setw(20) << st.lastArrival << " │\n";
+    std::cout << "│ Slots liberados:    " << std::setw(20) << st.reaped << " │\n";
+    std::cout << "│ Tiempo real (ms):   " << std::setw(20) << std::setprecision(1)
+              << st.elapsedMs << " │\n";
+    std::cout << "└──────────────────────────────────────────┘\n";
+}
+
+const char *arrivalModelName(ArrivalModel m) {
+    switch (m) {
+        case ArrivalModel::POISSON: return "Poisson";
+        case ArrivalModel::BURSTY: return "Ráfagas (on/off)";
+        case ArrivalModel::DIURNAL: return "Diurna";
+        default: return "?";
+    }
+}
+
+const char *burstModelName(BurstModel m) {
+    switch (m) {
+        case BurstModel::EXPONENTIAL: return "Exponencial";
+        case BurstModel::PARETO: return "Pareto";
+        case BurstModel::BIMODAL: return "Bimodal";
+        default: return "?";
+    }
+}
@@ -0,0 +1,124 @@
+#ifndef WORKLOAD_GENERATOR_H
+#define WORKLOAD_GENERATOR_H
+
+#include <random>
+#include <cstdint>
+#include "../cpu/Scheduler.h"
+
+// ========== MODELOS DE CARGA ==========
+enum class ArrivalModel {
+    POISSON,    // Llegadas independientes a tasa constante
+    BURSTY,     // Markov on/off: ráfagas a tasa alta separadas por calma
+    DIURNAL     // Tasa sinusoidal (ciclo día/noche), por thinning
+};
+
+enum class BurstModel {
+    EXPONENTIAL,    // Media meanBurst
+    PARETO,         // Cola pesada (alpha), misma media
+    BIMODAL         // Mezcla de trabajos cortos y largos
+};
+
+// ========== CONFIGURACIÓN ==========
+struct WorkloadConfig {
+    uint64_t seed;
+    long long numProcs;             // Procesos a generar
+
+    // Llegadas (tasa media en procesos por tick)
+    ArrivalModel arrival;
+    double arrivalRate;
+    double burstFactor;             // BURSTY: rate * factor en ráfaga, rate / factor en calma
+    double burstOnTicks;            // BURSTY: duración media de ráfaga / calma
+    double burstOffTicks;
+    double diurnalPeriod;           // DIURNAL: ticks por ciclo
+    double diurnalAmplitude;        // DIURNAL: 0..1
+
+    // Ráfagas de CPU
+    BurstModel burst;
+    double meanBurst;
+    double paretoAlpha;             // > 1
+    double bimodalShort;            // Media de los cortos
+    double bimodalLong;             // Media de los largos
+    double bimodalLongFraction;
+    int maxBurst;
+
+    // Páginas, hilos y tipo
+    int minPages;
+    int maxPages;
+    double threadedFraction;        // Procesos que además crean hilos
+    int maxThreads;                 // 1..maxThreads hilos por proceso con hilos
+    double meanThreadBurst;
+    double producerFraction;
+    double consumerFraction;
+
+    int reapInterval;               // Ticks entre reapTerminated() (0 = nunca)
+
+    WorkloadConfig();
+};
+
+// ========== PROCESO GENERADO ==========
+struct GeneratedProcess {
+    int arrivalTick;                // Relativo al inicio de la carga
+    int burst;
+    int pages;
+    ProcType type;
+    int threads;                    // Hilos a crear (sus ráfagas: nextThreadBurst)
+};
+
+// ========== RESUMEN DE UNA CORRIDA ==========
+struct WorkloadStats {
+    long long created;
+    long long threads;
+    long long producers;
+    long long consumers;
+    long long totalBurst;
+    long long reaped;
+    int lastArrival;
+    double elapsedMs;
+};
+
+// ========== GENERADOR ==========
+/**
+ * Generador de carga sintética con semilla: la misma configuración produce
+ * siempre la misma secuencia de procesos.
+ * - Uniformes propios sobre mt19937_64 (no std::*_distribution, que
+ *   varían entre bibliotecas estándar).
+ * - Produce un proceso a la vez en orden de llegada (memoria O(1)), así
+ *   una corrida de 10M procesos no materializa la carga completa.
+ * - run() avanza el planificador hasta cada llegada y crea el proceso y
+ *   sus hilos directamente con createProcess/createThreadInProcess.
+ * - Con reapInterval > 0 se liberan periódicamente los slots de los
+ *   procesos terminados para acotar la tabla en corridas largas.
+ */
+class WorkloadGenerator {
+private:
+    WorkloadConfig cfg;
+    std::mt19937_64 rng;
+    double clock;                   // Tiempo continuo de la última llegada
+    bool burstOn;                   // BURSTY: estado actual
+    double phaseEnd;                // BURSTY: fin del estado actual
+    long long generated;
+
+    double uniform();
+    double exponential(double mean);
+    double nextArrivalTime();
+    int sampleBurst();
+
+public:
+    explicit WorkloadGenerator(const WorkloadConfig &config);
+
+    void reset();
+    bool next(GeneratedProcess &p);
+    int nextThreadBurst();
+
+    WorkloadStats run(SchedulerCore &sched);
+    static void showStats(const WorkloadStats &stats);
+};
+
+// Avanza el planificador hasta 'tick' liberando los terminados cada
+// reapInterval ticks (nextReap se actualiza); devuelve los slots liberados
+long long advanceWithReap(SchedulerCore &sched, int tick, int reapInterval, int &nextReap);
+
+const char *arrivalModelName(ArrivalModel m);
+const char *burstModelName(BurstModel m);
+
+#endif // WORKLOAD_GENERATOR_H